@@ -0,0 +1,145 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include "graph.hpp"
+#include "list.hpp"
+#include "raggedarray.hpp"
+
+using namespace std;
+
+// single points of failure of a graph, edge directions are ignored
+//   articulationPoints   ids of the vertex whose removal disconnects their component
+//   bridges              positions in the edge view of the edges whose removal does the same
+//   components           one row of edge view positions per biconnected component
+//   edgeComponent        row of every edge view position, -1 for self loops
+struct Biconnectivity {
+    List<int> articulationPoints;
+    List<int> bridges;
+    RaggedArray<int> components;
+    List<int> edgeComponent;
+};
+
+Biconnectivity getBiconnectivity(Graph& graph);
+
+
+// tarjan low links on an explicit stack, O(V + E) and no recursion however deep the dfs goes
+// only the tree edge itself is skipped when looking back from a vertex, so a parallel edge is never a bridge
+Biconnectivity getBiconnectivity(Graph& graph) {
+    int numVertex = graph.getNumVertex();
+    View<Edge> edges = graph.getEdgeView();
+    vector<int> offset(numVertex + 1, 0), neighbor, incident, next;
+    vector<int> discovery(numVertex, -1), low(numVertex), parentEdge(numVertex, -1);
+    vector<int> stack, edgeStack;
+    vector<char> articulation(numVertex, 0);
+    Biconnectivity result;
+    int time = 0;
+
+    result.edgeComponent = List<int>(edges.size(), -1);
+
+    // both directions of every edge, with its position
+    vector<int> source(edges.size()), destination(edges.size());
+
+    for (int i = 0; i < edges.size(); i++) {
+        source[i] = graph.getVertexIndex(edges[i].getSource());
+        destination[i] = graph.getVertexIndex(edges[i].getDestination());
+
+        if (source[i] != destination[i]) {
+            offset[source[i] + 1]++;
+            offset[destination[i] + 1]++;
+        }
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        offset[i + 1] += offset[i];
+
+    next.assign(offset.begin(), offset.end() - 1);
+    neighbor.resize(offset[numVertex]);
+    incident.resize(offset[numVertex]);
+
+    for (int i = 0; i < edges.size(); i++) {
+        if (source[i] == destination[i])
+            continue;
+
+        neighbor[next[source[i]]] = destination[i];
+        incident[next[source[i]]++] = i;
+        neighbor[next[destination[i]]] = source[i];
+        incident[next[destination[i]]++] = i;
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        next[i] = offset[i];
+
+    for (int root = 0; root < numVertex; root++) {
+        int rootChildren = 0;
+
+        if (discovery[root] != -1)
+            continue;
+
+        discovery[root] = low[root] = time++;
+        stack.push_back(root);
+
+        while (!stack.empty()) {
+            int v = stack.back();
+
+            if (next[v] < offset[v + 1]) {
+                int w = neighbor[next[v]];
+                int e = incident[next[v]++];
+
+                if (e == parentEdge[v])
+                    continue;
+
+                if (discovery[w] == -1) {
+                    discovery[w] = low[w] = time++;
+                    parentEdge[w] = e;
+                    edgeStack.push_back(e);
+                    stack.push_back(w);
+                    rootChildren += v == root;
+                } else if (discovery[w] < discovery[v]) {
+                    // back edge, seen first from its lower end
+                    low[v] = min(low[v], discovery[w]);
+                    edgeStack.push_back(e);
+                }
+
+                continue;
+            }
+
+            // v is finished, its low link goes up to the parent
+            stack.pop_back();
+
+            if (v == root)
+                break;
+
+            int parent = stack.back();
+            low[parent] = min(low[parent], low[v]);
+
+            if (low[v] > discovery[parent])
+                result.bridges.insert(parentEdge[v]);
+
+            // nothing under v climbs above the parent, the edges pushed since the tree edge form a component
+            if (low[v] >= discovery[parent]) {
+                int e;
+
+                if (parent != root)
+                    articulation[parent] = 1;
+
+                do {
+                    e = edgeStack.back();
+                    edgeStack.pop_back();
+                    result.components.append(e);
+                    result.edgeComponent[e] = result.components.size();
+                } while (e != parentEdge[v]);
+
+                result.components.endRow();
+            }
+        }
+
+        if (rootChildren > 1)
+            articulation[root] = 1;
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        if (articulation[i])
+            result.articulationPoints.insert(graph.vertexAt(i));
+
+    return result;
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+
+#ifdef _WIN32
+    #include <io.h>
+    #define WRITER_OPEN_FLAGS (O_WRONLY | O_CREAT | O_TRUNC | O_BINARY)
+#else
+    #include <unistd.h>
+    #define WRITER_OPEN_FLAGS (O_WRONLY | O_CREAT | O_TRUNC)
+#endif
+
+using namespace std;
+
+// write-only file with a large user space buffer, the kernel only sees full buffers
+class BufferedWriter {
+    public:
+        BufferedWriter(string filePath, size_t capacity = 1 << 22);
+        BufferedWriter(const BufferedWriter& other) = delete;
+        BufferedWriter& operator=(const BufferedWriter& other) = delete;
+        ~BufferedWriter();
+        void write(char character);
+        void write(const char* text, size_t length);
+        void write(const string& text);
+        void writeInt(long value);
+        void flush();
+        void close();
+
+    private:
+        char* buffer = nullptr;
+        size_t capacity = 0;
+        size_t used = 0;
+        int fileDescriptor = -1;
+};
+
+
+// constructor, the file is created or truncated
+BufferedWriter::BufferedWriter(string filePath, size_t capacity) {
+    this->fileDescriptor = open(filePath.c_str(), WRITER_OPEN_FLAGS, 0644);
+
+    if (this->fileDescriptor < 0)
+        throw runtime_error("failed to create the output file");
+
+    this->capacity = capacity;
+    this->buffer = new char[capacity];
+}
+
+BufferedWriter::~BufferedWriter() {
+    try {
+        this->close();
+    } catch (exception& e) {
+        // nothing left to do for a failed write during destruction
+    }
+
+    delete[] this->buffer;
+}
+
+void BufferedWriter::write(char character) {
+    if (this->used == this->capacity)
+        this->flush();
+
+    this->buffer[this->used++] = character;
+}
+
+// large writes bypass the buffer
+void BufferedWriter::write(const char* text, size_t length) {
+    if (this->used + length > this->capacity)
+        this->flush();
+
+    if (length >= this->capacity) {
+        while (length > 0) {
+            long written = ::write(this->fileDescriptor, text, length);
+
+            if (written <= 0)
+                throw runtime_error("failed to write the output file");
+
+            text += written;
+            length -= written;
+        }
+
+        return;
+    }
+
+    memcpy(this->buffer + this->used, text, length);
+    this->used += length;
+}
+
+void BufferedWriter::write(const string& text) {
+    this->write(text.data(), text.size());
+}
+
+// format straight into the buffer, no locale and no intermediate string
+void BufferedWriter::writeInt(long value) {
+    // the longest long has 20 characters with its sign
+    if (this->capacity - this->used < 20)
+        this->flush();
+
+    to_chars_result result = to_chars(this->buffer + this->used, this->buffer + this->capacity, value);
+    this->used = result.ptr - this->buffer;
+}
+
+void BufferedWriter::flush() {
+    size_t offset = 0;
+
+    while (offset < this->used) {
+        long written = ::write(this->fileDescriptor, this->buffer + offset, this->used - offset);
+
+        if (written <= 0)
+            throw runtime_error("failed to write the output file");
+
+        offset += written;
+    }
+
+    this->used = 0;
+}
+
+void BufferedWriter::close() {
+    if (this->fileDescriptor < 0)
+        return;
+
+    this->flush();
+    ::close(this->fileDescriptor);
+    this->fileDescriptor = -1;
+}
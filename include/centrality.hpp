@@ -0,0 +1,365 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+#include <queue>
+#include <random>
+#include <cmath>
+#include <memory>
+#include "graph.hpp"
+#include "list.hpp"
+#include "threadpool.hpp"
+
+using namespace std;
+
+// sources handed to a thread at a time, every source is already a full traversal
+#define CENTRALITY_CHUNK 1
+
+// sampled betweenness, with probability 1 - delta every value is within errorBound of the exact one
+struct BetweennessEstimate {
+    List<double> centrality;
+    int numSources = 0;
+    double errorBound = 0;
+};
+
+// state of the single source shortest paths of one thread, only the entries of the visited
+// vertices are touched, so the arrays are allocated once per thread and cleaned in the time of a visit
+class ShortestPathSweep {
+    public:
+        ShortestPathSweep(Graph& graph, const vector<int>& edgeWeight);
+        void run(int source);
+        void accumulateDependencies(vector<double>& centrality);
+        void clear();
+        const vector<int>& getOrder();
+        long getDistance(int vertexIndex);
+
+    private:
+        Graph& graph;
+        const vector<int>& edgeWeight;
+        bool weighted;
+        vector<long> distance;
+        vector<double> sigma;
+        vector<double> dependency;
+        vector<int> order;
+};
+
+List<double> getBetweennessCentrality(Graph& graph);
+BetweennessEstimate getSampledBetweennessCentrality(Graph& graph, double epsilon, double delta = 0.1, unsigned int seed = 1);
+List<double> getClosenessCentrality(Graph& graph);
+List<double> getHarmonicCentrality(Graph& graph);
+vector<int> getCentralityWeights(Graph& graph);
+List<double> accumulateBetweenness(Graph& graph, const vector<int>& sources);
+
+
+// constructor, the views of the graph must be built before the threads share it
+ShortestPathSweep::ShortestPathSweep(Graph& graph, const vector<int>& edgeWeight) : graph(graph), edgeWeight(edgeWeight) {
+    int numVertex = graph.getNumVertex();
+
+    this->weighted = !edgeWeight.empty();
+    this->distance.assign(numVertex, -1);
+    this->sigma.assign(numVertex, 0);
+    this->dependency.assign(numVertex, 0);
+    this->order.reserve(numVertex);
+}
+
+// distances and number of shortest paths from the source, bfs without weights and dijkstra with them
+// order keeps the vertex by non decreasing distance, the order their dependencies are accumulated backwards
+void ShortestPathSweep::run(int source) {
+    this->clear();
+    this->distance[source] = 0;
+    this->sigma[source] = 1;
+
+    if (!this->weighted) {
+        this->order.push_back(source);
+
+        for (int head = 0; head < (int) this->order.size(); head++) {
+            int v = this->order[head];
+            View<int> adjacency = this->graph.getAdjacencyView(v);
+
+            for (int j = 0; j < adjacency.size(); j++) {
+                int w = adjacency[j];
+
+                if (this->distance[w] == -1) {
+                    this->distance[w] = this->distance[v] + 1;
+                    this->order.push_back(w);
+                }
+
+                if (this->distance[w] == this->distance[v] + 1)
+                    this->sigma[w] += this->sigma[v];
+            }
+        }
+
+        return;
+    }
+
+    priority_queue<pair<long, int>, vector<pair<long, int>>, greater<pair<long, int>>> queue;
+    queue.push({0, source});
+
+    while (!queue.empty()) {
+        long d = queue.top().first;
+        int v = queue.top().second;
+        queue.pop();
+
+        // stale entry, the vertex was settled with a smaller distance
+        if (d > this->distance[v])
+            continue;
+
+        this->order.push_back(v);
+
+        View<int> adjacency = this->graph.getAdjacencyView(v);
+        View<int> incident = this->graph.getIncidentEdgeView(v);
+
+        for (int j = 0; j < adjacency.size(); j++) {
+            int w = adjacency[j];
+            long candidate = d + this->edgeWeight[incident[j]];
+
+            if (w == v)
+                continue;
+
+            if (this->distance[w] == -1 or candidate < this->distance[w]) {
+                this->distance[w] = candidate;
+                this->sigma[w] = this->sigma[v];
+                queue.push({candidate, w});
+            } else if (candidate == this->distance[w]) {
+                this->sigma[w] += this->sigma[v];
+            }
+        }
+    }
+}
+
+// add the dependency of the last source on every other vertex it reached
+// the successors of a vertex are found again from its adjacency, no predecessor lists are kept
+void ShortestPathSweep::accumulateDependencies(vector<double>& centrality) {
+    for (int i = this->order.size() - 1; i >= 0; i--) {
+        int v = this->order[i];
+        View<int> adjacency = this->graph.getAdjacencyView(v);
+        View<int> incident = this->graph.getIncidentEdgeView(v);
+        double sum = 0;
+
+        for (int j = 0; j < adjacency.size(); j++) {
+            int w = adjacency[j];
+            long weight = this->weighted ? this->edgeWeight[incident[j]] : 1;
+
+            if (w != v and this->distance[w] == this->distance[v] + weight)
+                sum += (1 + this->dependency[w]) / this->sigma[w];
+        }
+
+        this->dependency[v] = this->sigma[v] * sum;
+
+        if (i > 0)
+            centrality[v] += this->dependency[v];
+    }
+}
+
+// reset the entries of the vertices reached by the last run
+void ShortestPathSweep::clear() {
+    for (int i = 0; i < (int) this->order.size(); i++) {
+        int v = this->order[i];
+
+        this->distance[v] = -1;
+        this->sigma[v] = 0;
+        this->dependency[v] = 0;
+    }
+
+    this->order.clear();
+}
+
+const vector<int>& ShortestPathSweep::getOrder() {
+    return this->order;
+}
+
+long ShortestPathSweep::getDistance(int vertexIndex) {
+    return this->distance[vertexIndex];
+}
+
+// weight of every edge by its position in the edge view, empty when the graph has no weights
+// edges without weight count as 1, weights must be positive: negative ones have no shortest paths, and a zero
+// weight edge would let dijkstra settle its head before its tail, counting the paths through it in the wrong order
+vector<int> getCentralityWeights(Graph& graph) {
+    vector<int> edgeWeight;
+
+    // the views are built here, before the threads read them
+    graph.getAdjacencyView(0);
+    graph.getIncidentEdgeView(0);
+
+    if (!graph.weighted())
+        return edgeWeight;
+
+    View<Edge> edges = graph.getEdgeView();
+    edgeWeight.resize(edges.size());
+
+    for (int i = 0; i < edges.size(); i++) {
+        edgeWeight[i] = edges[i].hasWeight() ? edges[i].getWeight() : 1;
+
+        if (edgeWeight[i] <= 0)
+            throw runtime_error("every edge weight must be positive for use this function");
+    }
+
+    return edgeWeight;
+}
+
+// brandes from the given sources in parallel, every thread sums into its own array and they are reduced at the end
+// a source may repeat, every occurrence counts
+List<double> accumulateBetweenness(Graph& graph, const vector<int>& sources) {
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = graph.getNumVertex();
+    vector<int> edgeWeight = getCentralityWeights(graph);
+    vector<unique_ptr<ShortestPathSweep>> sweeps(pool.size());
+    vector<vector<double>> partial(pool.size());
+    List<double> centrality(numVertex, 0.0);
+
+    pool.parallelFor(0, sources.size(), CENTRALITY_CHUNK, [&](long begin, long end, int threadId) {
+        if (!sweeps[threadId])
+            sweeps[threadId].reset(new ShortestPathSweep(graph, edgeWeight));
+
+        ShortestPathSweep& sweep = *sweeps[threadId];
+
+        if (partial[threadId].empty())
+            partial[threadId].assign(numVertex, 0);
+
+        for (long i = begin; i < end; i++) {
+            sweep.run(sources[i]);
+            sweep.accumulateDependencies(partial[threadId]);
+        }
+    });
+
+    for (int t = 0; t < (int) partial.size(); t++)
+        for (int i = 0; i < (int) partial[t].size(); i++)
+            centrality[i] += partial[t][i];
+
+    // every pair of an undirected graph was counted from both ends
+    if (!graph.directed())
+        for (int i = 0; i < numVertex; i++)
+            centrality[i] /= 2;
+
+    return centrality;
+}
+
+// exact betweenness, by vertex index, one traversal from every vertex
+// parallel edges are distinct paths and self loops are never on one
+List<double> getBetweennessCentrality(Graph& graph) {
+    vector<int> sources(graph.getNumVertex());
+
+    if (sources.empty())
+        return List<double>();
+
+    for (int i = 0; i < (int) sources.size(); i++)
+        sources[i] = i;
+
+    return accumulateBetweenness(graph, sources);
+}
+
+// betweenness from sources drawn uniformly with replacement, scaled to the whole vertex set
+// the dependency of a source on a vertex is at most n - 2, so by hoeffding and a union bound over the vertices
+// ln(2n / delta) / (2 epsilon^2) sources keep every value within epsilon n (n - 2) of the exact one,
+// with probability 1 - delta; when that is not less than n the exact values are cheaper
+BetweennessEstimate getSampledBetweennessCentrality(Graph& graph, double epsilon, double delta, unsigned int seed) {
+    int numVertex = graph.getNumVertex();
+    BetweennessEstimate estimate;
+    exception e;
+
+    if (epsilon <= 0 or delta <= 0 or delta >= 1)
+        throw e;
+
+    if (numVertex == 0)
+        return estimate;
+
+    double numSamples = ceil(log(2.0 * numVertex / delta) / (2 * epsilon * epsilon));
+
+    if (numSamples >= numVertex) {
+        estimate.centrality = getBetweennessCentrality(graph);
+        estimate.numSources = numVertex;
+        return estimate;
+    }
+
+    mt19937 generator(seed);
+    uniform_int_distribution<int> pick(0, numVertex - 1);
+    vector<int> sources(numSamples);
+
+    for (int i = 0; i < (int) sources.size(); i++)
+        sources[i] = pick(generator);
+
+    estimate.centrality = accumulateBetweenness(graph, sources);
+    estimate.numSources = sources.size();
+    estimate.errorBound = epsilon * numVertex * max(numVertex - 2, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        estimate.centrality[i] *= (double) numVertex / estimate.numSources;
+
+    if (!graph.directed())
+        estimate.errorBound /= 2;
+
+    return estimate;
+}
+
+// closeness from the distances of each vertex to the ones it reaches (r of them, itself included),
+// scaled by the reached fraction so vertex of small components do not look central: (r - 1)^2 / ((n - 1) sum)
+List<double> getClosenessCentrality(Graph& graph) {
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = graph.getNumVertex();
+    List<double> closeness(numVertex, 0.0);
+
+    if (numVertex == 0)
+        return closeness;
+
+    vector<int> edgeWeight = getCentralityWeights(graph);
+    vector<unique_ptr<ShortestPathSweep>> sweeps(pool.size());
+
+    pool.parallelFor(0, numVertex, CENTRALITY_CHUNK, [&](long begin, long end, int threadId) {
+        if (!sweeps[threadId])
+            sweeps[threadId].reset(new ShortestPathSweep(graph, edgeWeight));
+
+        ShortestPathSweep& sweep = *sweeps[threadId];
+
+        for (long v = begin; v < end; v++) {
+            const vector<int>& order = sweep.getOrder();
+            double sum = 0;
+
+            sweep.run(v);
+
+            for (int i = 1; i < (int) order.size(); i++)
+                sum += sweep.getDistance(order[i]);
+
+            if (order.size() > 1 and sum > 0)
+                closeness[v] = (order.size() - 1.0) * (order.size() - 1.0) / ((numVertex - 1.0) * sum);
+        }
+    });
+
+    return closeness;
+}
+
+// sum of the inverse distances from each vertex, unreachable vertex add nothing
+List<double> getHarmonicCentrality(Graph& graph) {
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = graph.getNumVertex();
+    List<double> harmonic(numVertex, 0.0);
+
+    if (numVertex == 0)
+        return harmonic;
+
+    vector<int> edgeWeight = getCentralityWeights(graph);
+    vector<unique_ptr<ShortestPathSweep>> sweeps(pool.size());
+
+    pool.parallelFor(0, numVertex, CENTRALITY_CHUNK, [&](long begin, long end, int threadId) {
+        if (!sweeps[threadId])
+            sweeps[threadId].reset(new ShortestPathSweep(graph, edgeWeight));
+
+        ShortestPathSweep& sweep = *sweeps[threadId];
+
+        for (long v = begin; v < end; v++) {
+            const vector<int>& order = sweep.getOrder();
+            double sum = 0;
+
+            sweep.run(v);
+
+            for (int i = 1; i < (int) order.size(); i++)
+                if (sweep.getDistance(order[i]) > 0)
+                    sum += 1.0 / sweep.getDistance(order[i]);
+
+            harmonic[v] = sum;
+        }
+    });
+
+    return harmonic;
+}
@@ -0,0 +1,333 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <tuple>
+#include <unordered_set>
+#include <algorithm>
+#include "graph.hpp"
+#include "list.hpp"
+#include "raggedarray.hpp"
+#include "threadpool.hpp"
+
+using namespace std;
+
+// vertex orders of the greedy coloring
+//   COLOR_LARGEST_FIRST   highest degree first
+//   COLOR_SMALLEST_LAST   reverse of the order that keeps removing a vertex of minimum degree,
+//                         never uses more colors than the degeneracy plus one
+//   COLOR_DSATUR          next the vertex seeing the most distinct colors, ties by degree, usually the fewest colors
+enum ColoringOrder {COLOR_LARGEST_FIRST, COLOR_SMALLEST_LAST, COLOR_DSATUR};
+
+List<int> getGreedyColoring(Graph& graph, ColoringOrder order);
+List<int> getParallelColoring(Graph& graph, unsigned int seed = 1);
+int getNumColors(const List<int>& colorList);
+RaggedArray<int> getColorClasses(Graph& graph, const List<int>& colorList);
+List<int> getSmallestLastOrder(Graph& graph);
+template <typename Callback> void forEachColoringNeighbor(Graph& graph, int vertexIndex, Callback callback);
+
+
+// call back with every neighbor index of the vertex, edge directions are ignored and self loops skipped
+template <typename Callback>
+void forEachColoringNeighbor(Graph& graph, int vertexIndex, Callback callback) {
+    View<int> adjacency = graph.getAdjacencyView(vertexIndex);
+
+    for (int j = 0; j < adjacency.size(); j++)
+        if (adjacency[j] != vertexIndex)
+            callback(adjacency[j]);
+
+    if (graph.directed()) {
+        View<int> reverseAdjacency = graph.getReverseAdjacencyView(vertexIndex);
+
+        for (int j = 0; j < reverseAdjacency.size(); j++)
+            if (reverseAdjacency[j] != vertexIndex)
+                callback(reverseAdjacency[j]);
+    }
+}
+
+// color of every vertex by index, from 0, adjacent vertex never share one
+// each vertex takes the smallest color none of its colored neighbors has
+List<int> getGreedyColoring(Graph& graph, ColoringOrder order) {
+    int numVertex = graph.getNumVertex();
+    vector<int> degree(numVertex, 0), color(numVertex, -1), usedBy(numVertex + 1, -1);
+    List<int> colorList(numVertex, -1);
+
+    for (int i = 0; i < numVertex; i++)
+        forEachColoringNeighbor(graph, i, [&](int) {
+            degree[i]++;
+        });
+
+    auto smallestFree = [&](int v) {
+        int c = 0;
+
+        forEachColoringNeighbor(graph, v, [&](int w) {
+            if (color[w] != -1)
+                usedBy[color[w]] = v;
+        });
+
+        while (usedBy[c] == v)
+            c++;
+
+        return c;
+    };
+
+    if (order == COLOR_DSATUR) {
+        // (saturation, degree, -index), an entry is stale once the vertex is colored or its saturation grew
+        priority_queue<tuple<int, int, int>> queue;
+        vector<unsigned long long> seenMask(numVertex, 0);
+        unordered_set<long long> seenColor;
+        vector<int> saturation(numVertex, 0);
+
+        for (int i = 0; i < numVertex; i++)
+            queue.push(make_tuple(0, degree[i], -i));
+
+        while (!queue.empty()) {
+            int v = -get<2>(queue.top());
+            int entrySaturation = get<0>(queue.top());
+            queue.pop();
+
+            if (color[v] != -1 or entrySaturation != saturation[v])
+                continue;
+
+            color[v] = smallestFree(v);
+
+            // colors already seen by a neighbor, the first 64 in a mask and the rest in a set
+            forEachColoringNeighbor(graph, v, [&](int w) {
+                if (color[w] != -1)
+                    return;
+
+                if (color[v] < 64) {
+                    if (seenMask[w] >> color[v] & 1)
+                        return;
+
+                    seenMask[w] |= 1ULL << color[v];
+                } else if (!seenColor.insert((long long) w * numVertex + color[v]).second) {
+                    return;
+                }
+
+                saturation[w]++;
+                queue.push(make_tuple(saturation[w], degree[w], -w));
+            });
+        }
+    } else {
+        List<int> orderList;
+
+        if (order == COLOR_SMALLEST_LAST) {
+            orderList = getSmallestLastOrder(graph);
+        } else {
+            vector<int> indexList(numVertex);
+
+            for (int i = 0; i < numVertex; i++)
+                indexList[i] = i;
+
+            stable_sort(indexList.begin(), indexList.end(), [&](int a, int b) {
+                return degree[a] > degree[b];
+            });
+
+            orderList.reserve(numVertex);
+
+            for (int i = 0; i < numVertex; i++)
+                orderList.insert(indexList[i]);
+        }
+
+        for (int i = 0; i < numVertex; i++)
+            color[orderList[i]] = smallestFree(orderList[i]);
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        colorList[i] = color[i];
+
+    return colorList;
+}
+
+// vertex indexes in smallest last order, the minimum degree vertex is removed repeatedly by degree bins
+// and the removal order is reversed, so every vertex has few neighbors colored before it
+List<int> getSmallestLastOrder(Graph& graph) {
+    int numVertex = graph.getNumVertex();
+    vector<int> degree(numVertex, 0), order(numVertex), position(numVertex);
+    int maxDegree = 0;
+
+    for (int i = 0; i < numVertex; i++) {
+        forEachColoringNeighbor(graph, i, [&](int) {
+            degree[i]++;
+        });
+
+        maxDegree = max(maxDegree, degree[i]);
+    }
+
+    // first position of each degree in the order
+    vector<int> bin(maxDegree + 2, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        bin[degree[i] + 1]++;
+
+    for (int d = 0; d <= maxDegree; d++)
+        bin[d + 1] += bin[d];
+
+    for (int i = 0; i < numVertex; i++) {
+        position[i] = bin[degree[i]]++;
+        order[position[i]] = i;
+    }
+
+    for (int d = maxDegree; d > 0; d--)
+        bin[d] = bin[d - 1];
+
+    bin[0] = 0;
+
+    for (int i = 0; i < numVertex; i++) {
+        int v = order[i];
+
+        // neighbors still in the graph move one bin down
+        forEachColoringNeighbor(graph, v, [&](int u) {
+            if (position[u] <= i or degree[u] <= degree[v])
+                return;
+
+            int first = bin[degree[u]];
+            int w = order[first];
+
+            if (w != u) {
+                order[position[u]] = w;
+                position[w] = position[u];
+                order[first] = u;
+                position[u] = first;
+            }
+
+            bin[degree[u]]++;
+            degree[u]--;
+        });
+    }
+
+    List<int> orderList(numVertex, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        orderList[i] = order[numVertex - 1 - i];
+
+    return orderList;
+}
+
+// jones-plassmann: every vertex gets a random priority and is colored once all its neighbors of higher priority are
+// each vertex counts the higher neighbors it waits for, and the thread that colors the last one of them queues it,
+// so the rounds do O(V + E) work in total
+// two vertex of the same round are never adjacent, and the lower neighbors of a vertex are not colored before it,
+// so no thread reads a color that is being written
+List<int> getParallelColoring(Graph& graph, unsigned int seed) {
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = graph.getNumVertex();
+    vector<unsigned long long> priority(numVertex);
+    vector<atomic<int>> waiting(numVertex);
+    vector<int> color(numVertex, -1), frontier;
+    vector<vector<int>> next(pool.size());
+    vector<vector<int>> usedBy(pool.size());
+    List<int> colorList(numVertex, -1);
+
+    if (numVertex == 0)
+        return colorList;
+
+    // the views are built here, before the threads read them
+    graph.getAdjacencyView(0);
+    graph.getReverseAdjacencyView(0);
+
+    // splitmix64 of the index in the high half, the index itself in the low half to break ties
+    for (int i = 0; i < numVertex; i++) {
+        unsigned long long z = i + 0x9e3779b97f4a7c15ULL * (seed + 1);
+
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        priority[i] = ((z ^ (z >> 31)) & ~0xffffffffULL) | (unsigned int) i;
+    }
+
+    pool.parallelFor(0, numVertex, [&](long begin, long end, int threadId) {
+        for (long v = begin; v < end; v++) {
+            int count = 0;
+
+            forEachColoringNeighbor(graph, v, [&](int w) {
+                count += priority[w] > priority[v];
+            });
+
+            waiting[v].store(count, memory_order_relaxed);
+
+            if (count == 0)
+                next[threadId].push_back(v);
+        }
+    });
+
+    while (true) {
+        frontier.clear();
+
+        for (int t = 0; t < (int) next.size(); t++) {
+            frontier.insert(frontier.end(), next[t].begin(), next[t].end());
+            next[t].clear();
+        }
+
+        if (frontier.empty())
+            break;
+
+        pool.parallelFor(0, frontier.size(), [&](long begin, long end, int threadId) {
+            vector<int>& used = usedBy[threadId];
+
+            for (long i = begin; i < end; i++) {
+                int v = frontier[i];
+                int c = 0;
+
+                // a color above the degree is never needed
+                forEachColoringNeighbor(graph, v, [&](int w) {
+                    if (color[w] != -1) {
+                        if ((int) used.size() <= color[w])
+                            used.resize(color[w] + 1, -1);
+
+                        used[color[w]] = v;
+                    }
+                });
+
+                while (c < (int) used.size() and used[c] == v)
+                    c++;
+
+                color[v] = c;
+
+                forEachColoringNeighbor(graph, v, [&](int w) {
+                    if (priority[w] < priority[v] and waiting[w].fetch_sub(1, memory_order_relaxed) == 1)
+                        next[threadId].push_back(w);
+                });
+            }
+        });
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        colorList[i] = color[i];
+
+    return colorList;
+}
+
+int getNumColors(const List<int>& colorList) {
+    int numColors = 0;
+
+    for (int i = 0; i < colorList.size(); i++)
+        numColors = max(numColors, colorList[i] + 1);
+
+    return numColors;
+}
+
+// ids of the vertex of each color, one row per color
+RaggedArray<int> getColorClasses(Graph& graph, const List<int>& colorList) {
+    int numColors = getNumColors(colorList);
+    RaggedArray<int> classes(numColors, colorList.size());
+    vector<int> offset(numColors + 1, 0), byColor(colorList.size());
+
+    for (int i = 0; i < colorList.size(); i++)
+        offset[colorList[i] + 1]++;
+
+    for (int c = 0; c < numColors; c++)
+        offset[c + 1] += offset[c];
+
+    for (int i = 0; i < colorList.size(); i++)
+        byColor[offset[colorList[i]]++] = graph.vertexAt(i);
+
+    for (int c = 0, i = 0; c < numColors; c++) {
+        for (; i < offset[c]; i++)
+            classes.append(byColor[i]);
+
+        classes.endRow();
+    }
+
+    return classes;
+}
@@ -0,0 +1,464 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include "graph.hpp"
+#include "externalgraph.hpp"
+#include "list.hpp"
+
+using namespace std;
+
+// read only adjacency with every neighbor list sorted and gap encoded in varints
+// row of vertex v, the first neighbor is relative to v and may be negative
+//
+//   varint(degree) varint(zigzag(n0 - v)) varint(n1 - n0) ... varint(nk - nk-1)
+//
+// neighbors close to their vertex or to each other take one byte, after a locality ordering
+// (see reordering.hpp) most of them are; the offsets are 64 bit so the bytes may pass 4 GB
+class CompressedNeighborIterator {
+    public:
+        CompressedNeighborIterator(const uint8_t* position, int remaining, int vertexIndex);
+        int operator*() const;
+        CompressedNeighborIterator& operator++();
+        bool operator==(const CompressedNeighborIterator& other) const;
+        bool operator!=(const CompressedNeighborIterator& other) const;
+
+    private:
+        const uint8_t* position;
+        int remaining;
+        int current = 0;
+};
+
+// neighbors of one vertex, decoded while iterating, the same shape as a view for range for loops
+class CompressedNeighborRange {
+    public:
+        CompressedNeighborRange(const uint8_t* first, int degree, int vertexIndex);
+        CompressedNeighborIterator begin() const;
+        CompressedNeighborIterator end() const;
+        int size() const;
+        bool empty() const;
+
+    private:
+        const uint8_t* first;
+        int degree;
+        int vertexIndex;
+};
+
+class CompressedAdjacency {
+    public:
+        CompressedAdjacency() = default;
+        static CompressedAdjacency fromGraph(Graph& graph, bool reverse = false);
+        static CompressedAdjacency fromExternalGraph(ExternalGraph& graph, bool reverse = false, long bufferEdges = 1 << 24);
+        static CompressedAdjacency load(string filePath);
+        void appendRow(vector<int>& neighbors);
+        void save(string filePath) const;
+        CompressedAdjacency transpose() const;
+        CompressedNeighborRange getAdjacencyView(int vertexIndex) const;
+        int getVertexDegree(int vertexIndex) const;
+        int getNumVertex() const;
+        long getNumEdges() const;
+        size_t memoryBytes() const;
+        List<int> getBFSOrder(int vertexIndex) const;
+        List<int> getDFSOrder(int vertexIndex) const;
+        int getNumComponents() const;
+        bool connected() const;
+        bool stronglyConnected(const CompressedAdjacency& reverse) const;
+
+    private:
+        vector<uint8_t> bytes;
+        vector<uint64_t> offsets = vector<uint64_t>(1, 0);
+        long numEdges = 0;
+        void writeVarint(uint64_t value);
+        int reached(int vertexIndex) const;
+};
+
+uint64_t readVarint(const uint8_t*& position);
+
+
+// decode one varint and move past it
+uint64_t readVarint(const uint8_t*& position) {
+    uint64_t value = 0;
+    int shift = 0;
+
+    while (*position & 0x80) {
+        value |= (uint64_t) (*position++ & 0x7f) << shift;
+        shift += 7;
+    }
+
+    return value | ((uint64_t) *position++ << shift);
+}
+
+CompressedNeighborIterator::CompressedNeighborIterator(const uint8_t* position, int remaining, int vertexIndex) {
+    this->position = position;
+    this->remaining = remaining;
+
+    // zigzag, small negative and positive distances both stay small
+    if (remaining > 0) {
+        uint64_t first = readVarint(this->position);
+        this->current = vertexIndex + ((long) (first >> 1) ^ -(long) (first & 1));
+    }
+}
+
+int CompressedNeighborIterator::operator*() const {
+    return this->current;
+}
+
+CompressedNeighborIterator& CompressedNeighborIterator::operator++() {
+    if (--this->remaining > 0)
+        this->current += readVarint(this->position);
+
+    return *this;
+}
+
+// iterators of the same row only differ by what is left of it
+bool CompressedNeighborIterator::operator==(const CompressedNeighborIterator& other) const {
+    return this->remaining == other.remaining;
+}
+
+bool CompressedNeighborIterator::operator!=(const CompressedNeighborIterator& other) const {
+    return this->remaining != other.remaining;
+}
+
+CompressedNeighborRange::CompressedNeighborRange(const uint8_t* first, int degree, int vertexIndex) {
+    this->first = first;
+    this->degree = degree;
+    this->vertexIndex = vertexIndex;
+}
+
+CompressedNeighborIterator CompressedNeighborRange::begin() const {
+    return CompressedNeighborIterator(this->first, this->degree, this->vertexIndex);
+}
+
+CompressedNeighborIterator CompressedNeighborRange::end() const {
+    return CompressedNeighborIterator(nullptr, 0, this->vertexIndex);
+}
+
+int CompressedNeighborRange::size() const {
+    return this->degree;
+}
+
+bool CompressedNeighborRange::empty() const {
+    return this->degree == 0;
+}
+
+// encode the adjacency of a graph by vertex index, the incoming one if reverse is set
+CompressedAdjacency CompressedAdjacency::fromGraph(Graph& graph, bool reverse) {
+    CompressedAdjacency adjacency;
+    vector<int> neighbors;
+
+    adjacency.offsets.reserve(graph.getNumVertex() + 1);
+
+    for (int i = 0; i < graph.getNumVertex(); i++) {
+        View<int> row = reverse ? graph.getReverseAdjacencyView(i) : graph.getAdjacencyView(i);
+
+        neighbors.assign(row.begin(), row.end());
+        adjacency.appendRow(neighbors);
+    }
+
+    adjacency.bytes.shrink_to_fit();
+    return adjacency;
+}
+
+// encode the adjacency of an edge file without building a graph, the incoming one if reverse is set
+// the edges on disk are not grouped by source, so every scan gathers the rows of the next vertex range
+// holding at most bufferEdges neighbors; only a degree per vertex and that buffer are kept besides the result
+CompressedAdjacency CompressedAdjacency::fromExternalGraph(ExternalGraph& graph, bool reverse, long bufferEdges) {
+    CompressedAdjacency adjacency;
+    int numVertex = graph.getNumVertex();
+    vector<int> degree(numVertex, 0);
+    vector<int> buffer, neighbors;
+    vector<long> offset;
+
+    // an undirected edge is in the rows of both endpoints, a self loop twice in its own
+    auto forEachEntry = [&](auto add) {
+        graph.scanEdges([&](int source, int destination) {
+            if (!graph.directed()) {
+                add(source, destination);
+                add(destination, source);
+            } else if (reverse) {
+                add(destination, source);
+            } else {
+                add(source, destination);
+            }
+        });
+    };
+
+    forEachEntry([&](int row, int) {
+        degree[row]++;
+    });
+
+    adjacency.offsets.reserve(numVertex + 1);
+
+    for (int first = 0, last = 0; first < numVertex; first = last) {
+        long count = 0;
+
+        // a row larger than the buffer still gets a scan of its own
+        while (last < numVertex and (last == first or count + degree[last] <= bufferEdges))
+            count += degree[last++];
+
+        offset.assign(last - first + 1, 0);
+        buffer.resize(count);
+
+        for (int v = first; v < last; v++)
+            offset[v - first + 1] = offset[v - first] + degree[v];
+
+        vector<long> next(offset.begin(), offset.end() - 1);
+
+        forEachEntry([&](int row, int neighbor) {
+            if (row >= first and row < last)
+                buffer[next[row - first]++] = neighbor;
+        });
+
+        for (int v = first; v < last; v++) {
+            neighbors.assign(buffer.begin() + offset[v - first], buffer.begin() + offset[v - first + 1]);
+            adjacency.appendRow(neighbors);
+        }
+    }
+
+    adjacency.bytes.shrink_to_fit();
+    return adjacency;
+}
+
+// add the row of the next vertex, the neighbors are sorted in place
+// rows can be appended while streaming edges grouped by source, no edge list is needed
+void CompressedAdjacency::appendRow(vector<int>& neighbors) {
+    int vertexIndex = this->getNumVertex();
+    long distance;
+
+    sort(neighbors.begin(), neighbors.end());
+    this->writeVarint(neighbors.size());
+
+    if (!neighbors.empty()) {
+        distance = (long) neighbors[0] - vertexIndex;
+        this->writeVarint(((uint64_t) distance << 1) ^ (uint64_t) (distance >> 63));
+    }
+
+    for (int i = 1; i < (int) neighbors.size(); i++)
+        this->writeVarint(neighbors[i] - neighbors[i - 1]);
+
+    this->offsets.push_back(this->bytes.size());
+    this->numEdges += neighbors.size();
+}
+
+// binary file: vertex count, edge count, byte count, offsets and bytes
+// written to a temporary file first, a failed write never leaves a partial file in its place
+void CompressedAdjacency::save(string filePath) const {
+    string temporaryPath = filePath + ".tmp";
+    ofstream output(temporaryPath, ios::binary | ios::trunc);
+    uint64_t header[3] = {(uint64_t) this->getNumVertex(), (uint64_t) this->numEdges, (uint64_t) this->bytes.size()};
+
+    if (!output.is_open())
+        throw runtime_error("failed to create the compressed adjacency file");
+
+    output.write((const char*) header, sizeof(header));
+    output.write((const char*) this->offsets.data(), this->offsets.size() * sizeof(uint64_t));
+    output.write((const char*) this->bytes.data(), this->bytes.size());
+    output.close();
+
+    if (!output) {
+        remove(temporaryPath.c_str());
+        throw runtime_error("failed to write the compressed adjacency file");
+    }
+
+// windows does not rename over an existing file
+#ifdef _WIN32
+    remove(filePath.c_str());
+#endif
+
+    if (rename(temporaryPath.c_str(), filePath.c_str()) != 0)
+        throw runtime_error("failed to replace the compressed adjacency file");
+}
+
+CompressedAdjacency CompressedAdjacency::load(string filePath) {
+    CompressedAdjacency adjacency;
+    ifstream input(filePath, ios::binary);
+    uint64_t header[3];
+
+    if (!input.is_open() or !input.read((char*) header, sizeof(header)))
+        throw runtime_error("failed to read the compressed adjacency file");
+
+    adjacency.numEdges = header[1];
+    adjacency.offsets.resize(header[0] + 1);
+    adjacency.bytes.resize(header[2]);
+
+    input.read((char*) adjacency.offsets.data(), adjacency.offsets.size() * sizeof(uint64_t));
+    input.read((char*) adjacency.bytes.data(), adjacency.bytes.size());
+
+    if (!input or adjacency.offsets.back() != header[2])
+        throw runtime_error("failed to read the compressed adjacency file");
+
+    return adjacency;
+}
+
+// the incoming adjacency, the rows are filled in one decoding pass over the outgoing ones
+// it needs an int per edge while building, the result is encoded as usual
+CompressedAdjacency CompressedAdjacency::transpose() const {
+    CompressedAdjacency transposed;
+    int numVertex = this->getNumVertex();
+    vector<long> offset(numVertex + 1, 0);
+    vector<int> sources(this->numEdges);
+    vector<int> neighbors;
+
+    for (int i = 0; i < numVertex; i++)
+        for (int adjIndex : this->getAdjacencyView(i))
+            offset[adjIndex + 1]++;
+
+    for (int i = 0; i < numVertex; i++)
+        offset[i + 1] += offset[i];
+
+    vector<long> next(offset.begin(), offset.end() - 1);
+
+    for (int i = 0; i < numVertex; i++)
+        for (int adjIndex : this->getAdjacencyView(i))
+            sources[next[adjIndex]++] = i;
+
+    transposed.offsets.reserve(numVertex + 1);
+
+    // sources arrive in increasing order, the rows are already sorted
+    for (int i = 0; i < numVertex; i++) {
+        neighbors.assign(sources.begin() + offset[i], sources.begin() + offset[i + 1]);
+        transposed.appendRow(neighbors);
+    }
+
+    transposed.bytes.shrink_to_fit();
+    return transposed;
+}
+
+CompressedNeighborRange CompressedAdjacency::getAdjacencyView(int vertexIndex) const {
+    const uint8_t* position = this->bytes.data() + this->offsets[vertexIndex];
+    int degree = readVarint(position);
+
+    return CompressedNeighborRange(position, degree, vertexIndex);
+}
+
+int CompressedAdjacency::getVertexDegree(int vertexIndex) const {
+    const uint8_t* position = this->bytes.data() + this->offsets[vertexIndex];
+    return readVarint(position);
+}
+
+int CompressedAdjacency::getNumVertex() const {
+    return this->offsets.size() - 1;
+}
+
+long CompressedAdjacency::getNumEdges() const {
+    return this->numEdges;
+}
+
+// bytes held by the encoded rows and their offsets
+size_t CompressedAdjacency::memoryBytes() const {
+    return this->bytes.capacity() + this->offsets.capacity() * sizeof(uint64_t);
+}
+
+// vertex indexes in bfs order from the vertex at vertexIndex
+List<int> CompressedAdjacency::getBFSOrder(int vertexIndex) const {
+    vector<char> visited(this->getNumVertex(), 0);
+    List<int> order;
+    int head = 0;
+
+    visited[vertexIndex] = 1;
+    order.insert(vertexIndex);
+
+    // the order list itself is the queue
+    while (head < order.size()) {
+        for (int adjIndex : this->getAdjacencyView(order[head++])) {
+            if (!visited[adjIndex]) {
+                visited[adjIndex] = 1;
+                order.insert(adjIndex);
+            }
+        }
+    }
+
+    return order;
+}
+
+// vertex indexes in dfs preorder, the stack keeps a decoding iterator per open vertex
+List<int> CompressedAdjacency::getDFSOrder(int vertexIndex) const {
+    vector<char> visited(this->getNumVertex(), 0);
+    vector<pair<CompressedNeighborIterator, CompressedNeighborIterator>> stack;
+    List<int> order;
+
+    visited[vertexIndex] = 1;
+    order.insert(vertexIndex);
+    stack.emplace_back(this->getAdjacencyView(vertexIndex).begin(), this->getAdjacencyView(vertexIndex).end());
+
+    while (!stack.empty()) {
+        CompressedNeighborIterator& it = stack.back().first;
+
+        if (it == stack.back().second) {
+            stack.pop_back();
+            continue;
+        }
+
+        int adjIndex = *it;
+        ++it;
+
+        if (!visited[adjIndex]) {
+            CompressedNeighborRange adjacency = this->getAdjacencyView(adjIndex);
+
+            visited[adjIndex] = 1;
+            order.insert(adjIndex);
+            stack.emplace_back(adjacency.begin(), adjacency.end());
+        }
+    }
+
+    return order;
+}
+
+// weak components by union find over the encoded rows, no reverse adjacency is needed
+int CompressedAdjacency::getNumComponents() const {
+    int numVertex = this->getNumVertex();
+    int numComponents = numVertex;
+    vector<int> parent(numVertex);
+
+    for (int i = 0; i < numVertex; i++)
+        parent[i] = i;
+
+    for (int i = 0; i < numVertex; i++) {
+        for (int adjIndex : this->getAdjacencyView(i)) {
+            int a = i, b = adjIndex;
+
+            while (parent[a] != a) a = parent[a] = parent[parent[a]];
+            while (parent[b] != b) b = parent[b] = parent[parent[b]];
+
+            if (a != b) {
+                parent[a] = b;
+                numComponents--;
+            }
+        }
+    }
+
+    return numComponents;
+}
+
+bool CompressedAdjacency::connected() const {
+    return this->getNumComponents() <= 1;
+}
+
+// every vertex reaches the first one and is reached by it, the reverse is the transposed adjacency
+bool CompressedAdjacency::stronglyConnected(const CompressedAdjacency& reverse) const {
+    int numVertex = this->getNumVertex();
+
+    if (numVertex == 0)
+        return true;
+
+    return this->reached(0) == numVertex and reverse.reached(0) == numVertex;
+}
+
+void CompressedAdjacency::writeVarint(uint64_t value) {
+    while (value >= 0x80) {
+        this->bytes.push_back((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+
+    this->bytes.push_back(value);
+}
+
+// number of vertex reached from the one at vertexIndex
+int CompressedAdjacency::reached(int vertexIndex) const {
+    return this->getBFSOrder(vertexIndex).size();
+}
@@ -6,36 +6,37 @@
 
 class Digraph : public Graph {
     public:
-        Digraph() = default;
+        Digraph();
         Digraph(List<int> vertexList);
         Digraph(List<int> vertexList, List<Edge> edgeList);
         Digraph(List<int> vertexList, List<Edge> edgeList, List<int> weightList);
-        void addEdge(Edge edge);
-        void removeEdge(Edge edge);
-        bool directed(); 
         bool connected();
         bool stronglyConnected(); 
         bool haveCycle(); 
         void transpose();
         List<int> getKahnTopologicalSort(); 
         List<int> getDFSTopologicalSort(); 
-        List<List<int>> getKosarajuComponents();
+        shared_ptr<const RaggedArray<int>> getKosarajuComponents();
+        Digraph getKCore(int k);
 
     private:
-        bool directGraph = true;
-        bool DFSCycle(int vertex, Digraph digraph, bool* visited, bool* recStack);
-        void DFSTopologicalSort(int vertex, Digraph digraph, bool* visited, List<int>& topList);
+        bool DFSCycle(int vertexIndex, Digraph& digraph, bool* visited, bool* recStack);
+        void DFSTopologicalSort(int vertexIndex, Digraph& digraph, bool* visited, List<int>& topList);
 };
 
+Digraph::Digraph() {
+    this->directGraph = true;
+}
+
 Digraph::Digraph(List<int> vertexList) {
-    this->vertexList = vertexList;
+    this->directGraph = true;
+    this->storage->vertexList = vertexList;
 }
 
 Digraph::Digraph(List<int> vertexList, List<Edge> edgeList) {
-    this->vertexList = vertexList;
-
-    for (int i = 0; i < edgeList.size(); i++) 
-        this->addEdge(edgeList[i]);
+    this->directGraph = true;
+    this->storage->vertexList = vertexList;
+    this->addEdges(edgeList);
 }
 
 Digraph::Digraph(List<int> vertexList, List<Edge> edgeList, List<int> weightList) {
@@ -44,71 +45,79 @@ Digraph::Digraph(List<int> vertexList, List<Edge> edgeList, List<int> weightList
     if (weightList.size() != edgeList.size()) 
         throw e;
     
-    this->vertexList = vertexList;
+    this->directGraph = true;
+    this->storage->vertexList = vertexList;
 
-    for (int i = 0; i < edgeList.size(); i++) {
+    for (int i = 0; i < edgeList.size(); i++) 
         edgeList[i].setWeight(weightList[i]);
-        this->addEdge(edgeList[i]);
-    }
-}
 
-void Digraph::removeEdge(Edge edge) {
-    this->edgeList.remove(edge);
+    this->addEdges(edgeList);
 }
 
-void Digraph::addEdge(Edge edge) {
-    exception e;
-
-    if (!this->hasVertex(edge.getSource()) or !this->hasVertex(edge.getDestination())) 
-        throw e;
-    
-    this->edgeList.insert(edge);}
+bool Digraph::connected() {
+    int result;
 
-bool Digraph::directed() {
-    return this->directGraph;
-}
+    if (this->cachedQuery(QUERY_DIGRAPH_CONNECTED, result))
+        return result;
 
-bool Digraph::connected() {
-    return Graph(this->vertexList, this->edgeList).connected();
+    return this->storeQuery(QUERY_DIGRAPH_CONNECTED, Graph(this->storage->vertexList, this->storage->edgeList).connected());
 }
 
 bool Digraph::stronglyConnected() {
     Digraph digraph = *this;
     int numVertex = digraph.getNumVertex();
-    int initialVertex = digraph.vertexAt(0);
+    int result;
+
+    if (this->cachedQuery(QUERY_STRONGLY_CONNECTED, result))
+        return result;
+
+    if (numVertex == 0)
+        return this->storeQuery(QUERY_STRONGLY_CONNECTED, true);
+
     bool visited[numVertex];
     
     for (int i = 0; i < numVertex; i++) 
         visited[i] = false;
 
-    this->DFS(initialVertex, digraph, visited);
+    this->DFS(0, digraph, visited);
 
     for (int i = 0; i < numVertex; i++) {
         if (!visited[i]) 
-            return false;
+            return this->storeQuery(QUERY_STRONGLY_CONNECTED, false);
 
         visited[i] = false;
     }
 
     digraph.transpose();
 
-    this->DFS(initialVertex, digraph, visited);
+    this->DFS(0, digraph, visited);
 
     for (int i = 0; i < numVertex; i++) 
         if (!visited[i]) 
-            return false;
+            return this->storeQuery(QUERY_STRONGLY_CONNECTED, false);
 
-    return true;
+    return this->storeQuery(QUERY_STRONGLY_CONNECTED, true);
 }
 
 void Digraph::transpose() {  
-    for (int i = 0; i < this->edgeList.size(); i++) 
-        edgeList[i].reverse();
+    this->detach();
+
+    for (int i = 0; i < this->storage->edgeList.size(); i++) 
+        this->storage->edgeList[i].reverse();
+
+    this->onEdgeListChange();
+
+    if (this->observer != nullptr)
+        this->observer->onTranspose();
 }
 
 bool Digraph::haveCycle() {
-    Digraph digraph = *this;
-    int numVertex = digraph.getNumVertex();
+    int numVertex = this->getNumVertex();
+    int result;
+
+    if (this->cachedQuery(QUERY_DIGRAPH_HAVE_CYCLE, result))
+        return result;
+
     bool visited[numVertex];
     bool recStack[numVertex];
 
@@ -117,33 +126,27 @@ bool Digraph::haveCycle() {
         recStack[i] = false;
     }
 
-    for (int i = 0; i < numVertex; i++) {
-        int vertex = digraph.vertexAt(i);
-
+    for (int i = 0; i < numVertex; i++) 
         if (!visited[i]) 
-            if (this->DFSCycle(vertex, digraph, visited, recStack)) 
-                return true;
-    }
+            if (this->DFSCycle(i, *this, visited, recStack)) 
+                return this->storeQuery(QUERY_DIGRAPH_HAVE_CYCLE, true);
   
-    return false;
+    return this->storeQuery(QUERY_DIGRAPH_HAVE_CYCLE, false);
 }
 
-bool Digraph::DFSCycle(int vertex, Digraph digraph, bool* visited, bool* recStack) {
-    int vertexIndex = digraph.getVertexIndex(vertex);
-
-    List<int> adjVertexList = digraph.getAdjacencyList()[vertexIndex];
+bool Digraph::DFSCycle(int vertexIndex, Digraph& digraph, bool* visited, bool* recStack) {
+    View<int> adjacency = digraph.getAdjacencyView(vertexIndex);
 
     visited[vertexIndex] = true;
     recStack[vertexIndex] = true;
 
-    for (int i = 0; i < adjVertexList.size(); i++) {
-        int adjVertex = adjVertexList[i];
-        int adjVertexIndex = digraph.getVertexIndex(adjVertex);
+    for (int i = 0; i < adjacency.size(); i++) {
+        int adjIndex = adjacency[i];
 
-        if (!visited[adjVertexIndex]) {
-            if (this->DFSCycle(adjVertex, digraph, visited, recStack)) 
+        if (!visited[adjIndex]) {
+            if (this->DFSCycle(adjIndex, digraph, visited, recStack)) 
                 return true;
-        } else if (recStack[adjVertexIndex]) {
+        } else if (recStack[adjIndex]) {
             return true;
         }
     }
@@ -161,7 +164,7 @@ List<int> Digraph::getKahnTopologicalSort() {
         for (int i = 0; i < digraph.getNumVertex(); i++) {
             int vertex = digraph.vertexAt(i);
 
-            if (digraph.getVertexDegree(vertex) == 0) {
+            if (digraph.getVertexInDegree(vertex) == 0) {
                 digraph.removeVertex(vertex);
                 topList.insert(vertex);
             }
@@ -172,82 +175,80 @@ List<int> Digraph::getKahnTopologicalSort() {
 }
 
 List<int> Digraph::getDFSTopologicalSort() {
-    Digraph digraph = *this;
-    int numVertex = digraph.getNumVertex();
+    int numVertex = this->getNumVertex();
     bool visited[numVertex];
     List<int> topList;
 
     for (int i = 0; i < numVertex; i++) 
         visited[i] = false;
     
-    for (int i = 0; i < numVertex; i++) {
-        int vertex = digraph.vertexAt(i);
-
+    for (int i = 0; i < numVertex; i++) 
         if (!visited[i]) 
-            this->DFSTopologicalSort(vertex, digraph, visited, topList);
-    }
+            this->DFSTopologicalSort(i, *this, visited, topList);
 
     topList.reverse();
 
     return topList;
 }
 
-void Digraph::DFSTopologicalSort(int vertex, Digraph digraph, bool* visited, List<int>& topList) {
-    int vertexIndex = digraph.getVertexIndex(vertex);
-
-    List<int> vertexList = digraph.getAdjacencyList()[vertexIndex];
+void Digraph::DFSTopologicalSort(int vertexIndex, Digraph& digraph, bool* visited, List<int>& topList) {
+    View<int> adjacency = digraph.getAdjacencyView(vertexIndex);
 
     visited[vertexIndex] = true;
 
-    for (int i = 0; i < vertexList.size(); i++) {
-        int adjVertex = vertexList[i];
-
-        if (!visited[i]) 
-            this->DFSTopologicalSort(adjVertex, digraph, visited, topList);
-    }
+    for (int i = 0; i < adjacency.size(); i++) 
+        if (!visited[adjacency[i]]) 
+            this->DFSTopologicalSort(adjacency[i], digraph, visited, topList);
 
-    topList.insert(vertex);
+    topList.insert(digraph.vertexAt(vertexIndex));
 }
 
-List<List<int>> Digraph::getKosarajuComponents() {
+// the rows are never written again, so the cached array is shared with the caller and with copies of the digraph
+shared_ptr<const RaggedArray<int>> Digraph::getKosarajuComponents() {
     Digraph digraph = *this;
-    List<int> recStack;
     int numVertex = digraph.getNumVertex();
+    int result;
+
+    if (this->cachedQuery(QUERY_COMPONENTS, result))
+        return this->storage->components;
+
+    RaggedArray<int> recStack(1, numVertex);
+    RaggedArray<int> components(numVertex, numVertex);
     bool visited[numVertex];
 
     for (int i = 0; i < numVertex; i++)
         visited[i] = false;
 
-    for (int i = 0; i < numVertex; i++) {
-        int vertex = digraph.vertexAt(i);
-
+    for (int i = 0; i < numVertex; i++) 
         if (!visited[i])
-            this->DFSRecStack(vertex, digraph, visited, recStack);
-    }
+            this->DFSRecStack(i, digraph, visited, recStack);
 
     for (int i = 0; i < numVertex; i++)
         visited[i] = false;
 
-    recStack.reverse();
+    recStack.endRow();
+    recStack.reverseRow(0);
     digraph.transpose();
 
-    List<int> newRecStack;
-    List<List<int>> components;
-
-    for (int i = 0; i < recStack.size(); i++) {
-        List<int> component;
-        int vertex = recStack[i];
-        int vertexIndex = digraph.getVertexIndex(vertex);
+    // each dfs on the transposed digraph fills one component row
+    for (int i = 0; i < numVertex; i++) {
+        int vertexIndex = digraph.getVertexIndex(recStack[0][i]);
 
         if (!visited[vertexIndex]) {
-            this->DFSRecStack(vertex, digraph, visited, newRecStack);
-
-            while (!newRecStack.empty()) 
-                component.insert(newRecStack.removeFirst());
-
-            components.insert(component);
+            this->DFSRecStack(vertexIndex, digraph, visited, components);
+            components.endRow();
         }
     }
 
-    return components;
+    this->storage->components = make_shared<const RaggedArray<int>>(move(components));
+    this->storeQuery(QUERY_COMPONENTS, this->storage->components->size());
+    return this->storage->components;
+}
+
+// the k-core keeps the edge directions
+Digraph Digraph::getKCore(int k) {
+    Digraph core(*this);
+
+    core.removeVertices(this->getVertexListOutsideCore(k));
+    return core;
 }
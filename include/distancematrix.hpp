@@ -0,0 +1,314 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include "graph.hpp"
+#include "list.hpp"
+#include "threadpool.hpp"
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+using namespace std;
+
+// tile side used by the blocked floyd-warshall, 64x64 ints fit three tiles in L2
+#define DISTANCE_TILE 64
+
+#if defined(__GNUC__)
+    // eight ints min-plus lane, lowered to whatever simd the target has
+    typedef int DistanceLane __attribute__((vector_size(32)));
+    #define DISTANCE_LANE_WIDTH 8
+#endif
+
+// dense all pairs distance matrix on a contiguous, tile aligned buffer
+class DistanceMatrix {
+    public:
+        static constexpr int infinity = 0x3f3f3f3f;
+        DistanceMatrix(int numVertex, string spillFilePath = "", bool forceSpill = false);
+        DistanceMatrix(DistanceMatrix&& other);
+        DistanceMatrix(const DistanceMatrix& other) = delete;
+        DistanceMatrix& operator=(const DistanceMatrix& other) = delete;
+        ~DistanceMatrix();
+        int* row(int index) const;
+        int at(int sourceIndex, int destinationIndex) const;
+        int size() const;
+        int stride() const;
+        bool spilled() const;
+        bool hasNegativeCycle() const;
+        void print(List<int> vertexList) const;
+
+    private:
+        int* data = nullptr;
+        int numVertex = 0;
+        int rowStride = 0;
+        size_t numBytes = 0;
+        bool mapped = false;
+        int fileDescriptor = -1;
+        bool fitsInMemory(size_t bytes) const;
+};
+
+// functions prototypes
+DistanceMatrix getFloydWarshallDistances(Graph& graph, string spillFilePath = "", bool forceSpill = false);
+void minPlusTile(int* c, const int* a, const int* b, int stride);
+
+
+// constructor, the buffer goes to a memory mapped file when it does not fit in RAM
+DistanceMatrix::DistanceMatrix(int numVertex, string spillFilePath, bool forceSpill) {
+    this->numVertex = numVertex;
+    this->rowStride = ((numVertex + DISTANCE_TILE - 1) / DISTANCE_TILE) * DISTANCE_TILE;
+
+    if (this->rowStride == 0)
+        this->rowStride = DISTANCE_TILE;
+
+    this->numBytes = (size_t) this->rowStride * this->rowStride * sizeof(int);
+
+#ifndef _WIN32
+    if (!spillFilePath.empty() and (forceSpill or !this->fitsInMemory(this->numBytes))) {
+        this->fileDescriptor = open(spillFilePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+        if (this->fileDescriptor < 0 or ftruncate(this->fileDescriptor, this->numBytes) != 0)
+            throw runtime_error("failed to create the distance matrix file");
+
+        void* address = mmap(nullptr, this->numBytes, PROT_READ | PROT_WRITE, MAP_SHARED, this->fileDescriptor, 0);
+
+        if (address == MAP_FAILED) {
+            close(this->fileDescriptor);
+            throw runtime_error("failed to map the distance matrix file");
+        }
+
+        this->data = (int*) address;
+        this->mapped = true;
+    }
+#endif
+
+    if (!this->mapped) {
+        this->data = (int*) aligned_alloc(64, this->numBytes);
+
+        if (this->data == nullptr)
+            throw bad_alloc();
+    }
+
+    // padding rows and columns stay at infinity and never shorten a path
+    ThreadPool::instance().parallelFor(0, this->rowStride, [this](long begin, long end, int) {
+        for (long i = begin; i < end; i++) {
+            int* line = this->row(i);
+
+            for (int j = 0; j < this->rowStride; j++)
+                line[j] = DistanceMatrix::infinity;
+
+            if (i < this->numVertex)
+                line[i] = 0;
+        }
+    });
+}
+
+// move constructor
+DistanceMatrix::DistanceMatrix(DistanceMatrix&& other) {
+    this->data = other.data;
+    this->numVertex = other.numVertex;
+    this->rowStride = other.rowStride;
+    this->numBytes = other.numBytes;
+    this->mapped = other.mapped;
+    this->fileDescriptor = other.fileDescriptor;
+
+    other.data = nullptr;
+    other.mapped = false;
+    other.fileDescriptor = -1;
+}
+
+DistanceMatrix::~DistanceMatrix() {
+    if (this->data == nullptr)
+        return;
+
+#ifndef _WIN32
+    if (this->mapped) {
+        munmap(this->data, this->numBytes);
+        close(this->fileDescriptor);
+        return;
+    }
+#endif
+
+    free(this->data);
+}
+
+// return a pointer to the start of a matrix row
+int* DistanceMatrix::row(int index) const {
+    return this->data + (size_t) index * this->rowStride;
+}
+
+// return the distance between two vertex indexes
+int DistanceMatrix::at(int sourceIndex, int destinationIndex) const {
+    return this->row(sourceIndex)[destinationIndex];
+}
+
+// return the number of vertex
+int DistanceMatrix::size() const {
+    return this->numVertex;
+}
+
+// return the padded row length
+int DistanceMatrix::stride() const {
+    return this->rowStride;
+}
+
+// return true if the matrix lives in a memory mapped file
+bool DistanceMatrix::spilled() const {
+    return this->mapped;
+}
+
+// a negative diagonal means some vertex reaches itself with negative cost
+bool DistanceMatrix::hasNegativeCycle() const {
+    for (int i = 0; i < this->numVertex; i++)
+        if (this->at(i, i) < 0)
+            return true;
+
+    return false;
+}
+
+void DistanceMatrix::print(List<int> vertexList) const {
+    cout << "  ";
+    for (int i = 0; i < this->numVertex; i++)
+        cout << vertexList[i] << " ";
+    cout << endl;
+
+    for (int i = 0; i < this->numVertex; i++) {
+        cout << vertexList[i] << " ";
+        for (int j = 0; j < this->numVertex; j++) {
+            if (this->at(i, j) == DistanceMatrix::infinity)
+                cout << "- ";
+            else
+                cout << this->at(i, j) << " ";
+        }
+        cout << endl;
+    }
+}
+
+// check the bytes against the physical memory currently available
+bool DistanceMatrix::fitsInMemory(size_t bytes) const {
+#if defined(_SC_AVPHYS_PAGES) && defined(_SC_PAGESIZE)
+    long pages = sysconf(_SC_AVPHYS_PAGES);
+    long pageSize = sysconf(_SC_PAGESIZE);
+
+    if (pages > 0 and pageSize > 0)
+        return bytes < (size_t) pages * pageSize;
+#endif
+
+    return true;
+}
+
+// c[i][j] = min(c[i][j], a[i][k] + b[k][j]) over one tile, c may alias a or b
+void minPlusTile(int* c, const int* a, const int* b, int stride) {
+    for (int k = 0; k < DISTANCE_TILE; k++) {
+        const int* bRow = b + (size_t) k * stride;
+
+        for (int i = 0; i < DISTANCE_TILE; i++) {
+            int aik = a[(size_t) i * stride + k];
+
+            // unreachable through k, nothing to relax
+            if (aik >= DistanceMatrix::infinity / 2)
+                continue;
+
+            int* cRow = c + (size_t) i * stride;
+
+#if defined(__GNUC__)
+            for (int j = 0; j < DISTANCE_TILE; j += DISTANCE_LANE_WIDTH) {
+                DistanceLane bLane, cLane;
+                memcpy(&bLane, bRow + j, sizeof(DistanceLane));
+                memcpy(&cLane, cRow + j, sizeof(DistanceLane));
+
+                DistanceLane sum = bLane + aik;
+                cLane = sum < cLane ? sum : cLane;
+                memcpy(cRow + j, &cLane, sizeof(DistanceLane));
+            }
+#else
+            for (int j = 0; j < DISTANCE_TILE; j++) {
+                int sum = aik + bRow[j];
+                if (sum < cRow[j])
+                    cRow[j] = sum;
+            }
+#endif
+        }
+    }
+}
+
+// blocked floyd-warshall, edges without weight count as 1
+DistanceMatrix getFloydWarshallDistances(Graph& graph, string spillFilePath, bool forceSpill) {
+    int numVertex = graph.getNumVertex();
+    DistanceMatrix distances(numVertex, spillFilePath, forceSpill);
+    ThreadPool& pool = ThreadPool::instance();
+    View<Edge> edges = graph.getEdgeView();
+
+    // parallel edges keep the cheapest one
+    for (int source = 0; source < numVertex; source++) {
+        View<int> adjacency = graph.getAdjacencyView(source);
+        View<int> incident = graph.getIncidentEdgeView(source);
+        int* line = distances.row(source);
+
+        for (int i = 0; i < adjacency.size(); i++) {
+            const Edge& edge = edges[incident[i]];
+            int destination = adjacency[i];
+            int weight = edge.hasWeight() ? edge.getWeight() : 1;
+
+            if (weight < line[destination])
+                line[destination] = weight;
+        }
+    }
+
+    int stride = distances.stride();
+    int numTiles = stride / DISTANCE_TILE;
+
+    auto tile = [&](int tileRow, int tileColumn) {
+        return distances.row(tileRow * DISTANCE_TILE) + tileColumn * DISTANCE_TILE;
+    };
+
+    for (int k = 0; k < numTiles; k++) {
+        // phase 1: the diagonal tile depends only on itself
+        minPlusTile(tile(k, k), tile(k, k), tile(k, k), stride);
+
+        // phase 2: tiles on row k and column k depend on the diagonal tile
+        pool.parallelFor(0, 2 * numTiles, 1, [&](long begin, long end, int) {
+            for (long t = begin; t < end; t++) {
+                int other = t % numTiles;
+
+                if (other == k)
+                    continue;
+
+                if (t < numTiles)
+                    minPlusTile(tile(k, other), tile(k, k), tile(k, other), stride);
+                else
+                    minPlusTile(tile(other, k), tile(other, k), tile(k, k), stride);
+            }
+        });
+
+        // phase 3: every remaining tile depends on its row and column tiles
+        pool.parallelFor(0, (long) numTiles * numTiles, 1, [&](long begin, long end, int) {
+            for (long t = begin; t < end; t++) {
+                int i = t / numTiles;
+                int j = t % numTiles;
+
+                if (i == k or j == k)
+                    continue;
+
+                minPlusTile(tile(i, j), tile(i, k), tile(k, j), stride);
+            }
+        });
+    }
+
+    // negative edges may have pulled unreachable entries slightly below infinity
+    pool.parallelFor(0, numVertex, [&](long begin, long end, int) {
+        for (long i = begin; i < end; i++) {
+            int* line = distances.row(i);
+
+            for (int j = 0; j < numVertex; j++)
+                if (line[j] >= DistanceMatrix::infinity / 2)
+                    line[j] = DistanceMatrix::infinity;
+        }
+    });
+
+    return distances;
+}
@@ -0,0 +1,384 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstdio>
+#include <sys/stat.h>
+#include "list.hpp"
+#include "bufferedwriter.hpp"
+
+using namespace std;
+
+// semi-external graph, the vertex state lives in memory and the edges stay on disk
+// the edge file is written once from the text file and only read sequentially, in blocks
+//
+//   source index, destination index     int32 pairs, one per stored edge
+//   vertex ids                          int32, in text file order
+//   vertex count, edge count, magic     int64 trailer
+//
+// every algorithm is a number of full scans over the edges, counted by getNumScans
+class ExternalGraph {
+    public:
+        ExternalGraph(string edgeFilePath, bool directed, long blockEdges = 1 << 20);
+        static void fromTextFile(string textFilePath, string edgeFilePath);
+        static bool upToDate(string textFilePath, string edgeFilePath);
+        template <typename Callback> void scanEdges(Callback callback);
+        int getNumVertex();
+        long getNumEdges();
+        int vertexAt(int index);
+        bool directed();
+        long getNumScans();
+        List<int> getBFSDistances(int vertexIndex);
+        List<int> getComponents();
+        int getNumComponents();
+        bool connected();
+        List<int> getStrongComponents();
+        int getNumStrongComponents();
+        bool stronglyConnected();
+
+    private:
+        string edgeFilePath;
+        vector<int> vertexList;
+        long numEdges;
+        long blockEdges;
+        long numScans = 0;
+        bool directGraph;
+        static constexpr int64_t magic = 0x4547444546494c45;
+};
+
+
+// constructor, only the vertex ids are loaded
+ExternalGraph::ExternalGraph(string edgeFilePath, bool directed, long blockEdges) {
+    ifstream input(edgeFilePath, ios::binary);
+    int64_t trailer[3];
+
+    if (!input.is_open() or !input.seekg(-(long) sizeof(trailer), ios::end) or !input.read((char*) trailer, sizeof(trailer)) or
+        trailer[2] != ExternalGraph::magic)
+        throw runtime_error("failed to read the edge file");
+
+    this->edgeFilePath = edgeFilePath;
+    this->directGraph = directed;
+    this->blockEdges = blockEdges;
+    this->numEdges = trailer[1];
+    this->vertexList.resize(trailer[0]);
+
+    input.seekg(this->numEdges * 2 * sizeof(int32_t));
+
+    if (!input.read((char*) this->vertexList.data(), this->vertexList.size() * sizeof(int32_t)))
+        throw runtime_error("failed to read the edge file");
+}
+
+// stream the text file into an edge file, only the vertex ids and their indexes are kept in memory
+// weights are not needed by the traversals and are skipped
+void ExternalGraph::fromTextFile(string textFilePath, string edgeFilePath) {
+    ifstream input(textFilePath, ios::binary);
+    vector<char> block(1 << 20);
+    vector<int32_t> vertexList;
+    unordered_map<int, int> vertexIndexMap;
+    string temporaryPath = edgeFilePath + ".tmp";
+    long position = 0, length = 0;
+    int section = 0;
+    long numEdges = 0;
+    bool pending = false;
+    int source = 0;
+    exception e;
+
+    if (!input.is_open())
+        throw runtime_error("failed to open the graph file");
+
+    BufferedWriter output(temporaryPath);
+
+    auto next = [&]() -> int {
+        if (position == length) {
+            input.read(block.data(), block.size());
+            length = input.gcount();
+            position = 0;
+
+            if (length == 0)
+                return EOF;
+        }
+
+        return (unsigned char) block[position++];
+    };
+
+    // a failed parse must not leave a partial edge file newer than the text, so it is renamed only when complete
+    try {
+        // the numbers of "V = {...}" are vertex, the ones of "A = {...}" come in source and destination pairs
+        for (int c = next(); c != EOF and section < 2; ) {
+            if (c == '{') {
+                c = next();
+
+                while (c != EOF and c != '}') {
+                    if (c != '-' and (c < '0' or c > '9')) {
+                        c = next();
+                        continue;
+                    }
+
+                    bool negative = c == '-';
+                    long value = 0;
+
+                    if (negative)
+                        c = next();
+
+                    for (; c >= '0' and c <= '9'; c = next())
+                        value = 10 * value + (c - '0');
+
+                    if (negative)
+                        value = -value;
+
+                    if (section == 0) {
+                        vertexIndexMap.emplace(value, vertexList.size());
+                        vertexList.push_back(value);
+                        continue;
+                    }
+
+                    auto it = vertexIndexMap.find(value);
+
+                    if (it == vertexIndexMap.end())
+                        throw e;
+
+                    if (pending) {
+                        int32_t edge[2] = {source, it->second};
+
+                        output.write((const char*) edge, sizeof(edge));
+                        numEdges++;
+                    } else {
+                        source = it->second;
+                    }
+
+                    pending = !pending;
+                }
+
+                section++;
+            }
+
+            c = next();
+        }
+
+        if (section < 2 or pending)
+            throw e;
+
+        int64_t trailer[3] = {(int64_t) vertexList.size(), numEdges, ExternalGraph::magic};
+
+        output.write((const char*) vertexList.data(), vertexList.size() * sizeof(int32_t));
+        output.write((const char*) trailer, sizeof(trailer));
+        output.close();
+    } catch (exception& error) {
+        output.close();
+        remove(temporaryPath.c_str());
+        throw;
+    }
+
+// windows does not rename over an existing file
+#ifdef _WIN32
+    remove(edgeFilePath.c_str());
+#endif
+
+    if (rename(temporaryPath.c_str(), edgeFilePath.c_str()) != 0)
+        throw runtime_error("failed to replace the edge file");
+}
+
+// true if the edge file exists and is strictly newer than the text file, in nanoseconds where the system has them
+// equal times count as stale, an edit in the same clock tick as the build only costs a rebuild
+bool ExternalGraph::upToDate(string textFilePath, string edgeFilePath) {
+    struct stat textStatus, edgeStatus;
+
+    if (stat(textFilePath.c_str(), &textStatus) != 0 or stat(edgeFilePath.c_str(), &edgeStatus) != 0)
+        return false;
+
+    auto modificationTime = [](const struct stat& status) -> long long {
+#if defined(_WIN32)
+        return status.st_mtime * 1000000000LL;
+#elif defined(__APPLE__)
+        return status.st_mtimespec.tv_sec * 1000000000LL + status.st_mtimespec.tv_nsec;
+#else
+        return status.st_mtim.tv_sec * 1000000000LL + status.st_mtim.tv_nsec;
+#endif
+    };
+
+    return modificationTime(edgeStatus) > modificationTime(textStatus);
+}
+
+// call back with the source and destination indexes of every edge, in file order
+template <typename Callback>
+void ExternalGraph::scanEdges(Callback callback) {
+    ifstream input(this->edgeFilePath, ios::binary);
+    vector<int32_t> block(2 * this->blockEdges);
+    long remaining = this->numEdges;
+
+    if (!input.is_open())
+        throw runtime_error("failed to open the edge file");
+
+    this->numScans++;
+
+    while (remaining > 0) {
+        long count = min(remaining, this->blockEdges);
+
+        if (!input.read((char*) block.data(), count * 2 * sizeof(int32_t)))
+            throw runtime_error("failed to read the edge file");
+
+        for (long i = 0; i < count; i++)
+            callback(block[2 * i], block[2 * i + 1]);
+
+        remaining -= count;
+    }
+}
+
+int ExternalGraph::getNumVertex() {
+    return this->vertexList.size();
+}
+
+long ExternalGraph::getNumEdges() {
+    return this->numEdges;
+}
+
+int ExternalGraph::vertexAt(int index) {
+    return this->vertexList[index];
+}
+
+bool ExternalGraph::directed() {
+    return this->directGraph;
+}
+
+long ExternalGraph::getNumScans() {
+    return this->numScans;
+}
+
+// edges from a vertex at the current level settle their unvisited endpoint, one scan per level
+// a vertex settled during a scan is not expanded in the same scan, so every distance is exact
+List<int> ExternalGraph::getBFSDistances(int vertexIndex) {
+    List<int> distance(this->getNumVertex(), -1);
+    bool grown = true;
+
+    distance[vertexIndex] = 0;
+
+    for (int level = 0; grown; level++) {
+        grown = false;
+
+        this->scanEdges([&](int source, int destination) {
+            if (distance[source] == level and distance[destination] == -1) {
+                distance[destination] = level + 1;
+                grown = true;
+            } else if (!this->directGraph and distance[destination] == level and distance[source] == -1) {
+                distance[source] = level + 1;
+                grown = true;
+            }
+        });
+    }
+
+    return distance;
+}
+
+// weak components by union find in a single scan, the label of a vertex is the index of its root
+List<int> ExternalGraph::getComponents() {
+    int numVertex = this->getNumVertex();
+    List<int> parent(numVertex, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        parent[i] = i;
+
+    auto find = [&](int a) {
+        while (parent[a] != a) a = parent[a] = parent[parent[a]];
+        return a;
+    };
+
+    this->scanEdges([&](int source, int destination) {
+        int a = find(source), b = find(destination);
+
+        if (a != b)
+            parent[a] = b;
+    });
+
+    for (int i = 0; i < numVertex; i++)
+        parent[i] = find(i);
+
+    return parent;
+}
+
+int ExternalGraph::getNumComponents() {
+    List<int> label = this->getComponents();
+    int numComponents = 0;
+
+    for (int i = 0; i < label.size(); i++)
+        numComponents += label[i] == i;
+
+    return numComponents;
+}
+
+bool ExternalGraph::connected() {
+    return this->getNumComponents() <= 1;
+}
+
+// strong components by coloring: the largest index reaching each vertex colors it, then every color root
+// collects the vertex of its color that reach it backwards, which form its component
+// both phases repeat scans until nothing changes, updates made during a scan are seen by the rest of it
+// the label of a vertex is the index of its component root, undirected graphs fall back to components
+List<int> ExternalGraph::getStrongComponents() {
+    int numVertex = this->getNumVertex();
+    List<int> component(numVertex, -1);
+    List<int> color(numVertex, 0);
+    int numAssigned = 0;
+
+    if (!this->directGraph)
+        return this->getComponents();
+
+    while (numAssigned < numVertex) {
+        bool changed = true;
+
+        for (int i = 0; i < numVertex; i++)
+            color[i] = i;
+
+        while (changed) {
+            changed = false;
+
+            this->scanEdges([&](int source, int destination) {
+                if (component[source] == -1 and component[destination] == -1 and color[source] > color[destination]) {
+                    color[destination] = color[source];
+                    changed = true;
+                }
+            });
+        }
+
+        for (int i = 0; i < numVertex; i++) {
+            if (component[i] == -1 and color[i] == i) {
+                component[i] = i;
+                numAssigned++;
+            }
+        }
+
+        changed = true;
+
+        while (changed) {
+            changed = false;
+
+            this->scanEdges([&](int source, int destination) {
+                if (component[source] == -1 and component[destination] != -1 and component[destination] == color[source] and
+                    color[destination] == color[source]) {
+                    component[source] = color[source];
+                    numAssigned++;
+                    changed = true;
+                }
+            });
+        }
+    }
+
+    return component;
+}
+
+int ExternalGraph::getNumStrongComponents() {
+    List<int> label = this->getStrongComponents();
+    int numComponents = 0;
+
+    for (int i = 0; i < label.size(); i++)
+        numComponents += label[i] == i;
+
+    return numComponents;
+}
+
+bool ExternalGraph::stronglyConnected() {
+    return this->getNumStrongComponents() <= 1;
+}
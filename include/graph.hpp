@@ -4,7 +4,14 @@
 #include <string>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <unordered_map>
+#include <atomic>
+#include <memory>
 #include "list.hpp"
+#include "view.hpp"
+#include "raggedarray.hpp"
+#include "threadpool.hpp"
 
 using namespace std;
 
@@ -32,7 +39,74 @@ class Edge {
     private:
         int source;
         int destination;
-        int* weight = nullptr;
+        int weight = 0;
+        bool weightDefined = false;
+};
+
+
+// receives the mutations applied to a graph object, its copies are not observed
+class GraphObserver {
+    public:
+        virtual ~GraphObserver() = default;
+        virtual void onAddVertex(int vertex) = 0;
+        virtual void onRemoveVertices(View<int> vertexList) = 0;
+        virtual void onAddEdges(View<Edge> edgeList) = 0;
+        virtual void onRemoveEdges(View<Edge> edgeList) = 0;
+        virtual void onTranspose() = 0;
+};
+
+// read only queries whose results are kept until the next mutation
+enum GraphQuery {
+    QUERY_CONNECTED,
+    QUERY_HAVE_CYCLE,
+    QUERY_WEIGHTED,
+    QUERY_ODD_DEGREE,
+    QUERY_ALONE_VERTEX,
+    QUERY_DIGRAPH_CONNECTED,
+    QUERY_DIGRAPH_HAVE_CYCLE,
+    QUERY_STRONGLY_CONNECTED,
+    QUERY_COMPONENTS,
+    QUERY_MULTIGRAPH,
+    NUM_GRAPH_QUERIES
+};
+
+const string graphQueryNames[NUM_GRAPH_QUERIES] = {
+    "connected", "have cycle", "weighted", "odd degree count", "alone vertex",
+    "digraph connected", "digraph have cycle", "strongly connected", "strong components",
+    "multigraph"
+};
+
+// hits and misses of the query cache, counted over every graph
+struct QueryCacheStats {
+    long hits[NUM_GRAPH_QUERIES] = {};
+    long misses[NUM_GRAPH_QUERIES] = {};
+};
+
+// vertices, edges and their derived caches, shared by graph copies until one of them changes
+// an undirected edge is stored once, the adjacency lists it under both endpoints
+struct GraphStorage {
+    List<Edge> edgeList;
+    List<int> vertexList;
+    List<List<int>> adjacencyMatrix;
+    List<int> inDegreeList;
+    List<int> outDegreeList;
+    unordered_map<int, int> vertexIndexMap;
+    vector<int> adjacencyOffset;
+    vector<int> adjacencyIndex;
+    vector<int> adjacencyEdge;
+    vector<int> reverseAdjacencyOffset;
+    vector<int> reverseAdjacencyIndex;
+    bool degreeListsUpdated = false;
+    bool vertexIndexUpdated = false;
+    bool adjacencyViewUpdated = false;
+    bool reverseAdjacencyViewUpdated = false;
+
+    // every mutation bumps the version, a query result is valid while its version matches
+    unsigned long version = 0;
+    unsigned long queryVersion[NUM_GRAPH_QUERIES] = {};
+    int queryResult[NUM_GRAPH_QUERIES] = {};
+    List<int> aloneVertexList;
+    shared_ptr<const RaggedArray<int>> components;
 };
 
 
@@ -42,34 +116,56 @@ class Graph {
         Graph(List<int> vertexList); 
         Graph(List<int> vertexList, List<Edge> edgeList); 
         Graph(List<int> vertexList, List<Edge> edgeList, List<int> weightList);
-        Graph(Graph& other);
+        Graph(const Graph& other);
         Graph(Graph&& other); 
-        Graph& operator=(Graph& other); 
+        Graph& operator=(const Graph& other); 
         Graph& operator=(Graph&& other); 
         virtual void addEdge(Edge edge);
+        virtual void addEdges(const List<Edge>& edgeList);
         void addVertex(int vertex);
         virtual void removeEdge(Edge edge);
+        virtual void removeEdges(const List<Edge>& edgeList);
         void removeVertex(int vertex);
+        void removeVertices(const List<int>& vertexList);
+        void permuteVertices(const List<int>& order);
+        void setObserver(GraphObserver* observer);
+        unsigned long getVersion();
+        static QueryCacheStats& getQueryCacheStats();
+        static void printQueryCacheStats();
         bool hasEdge(Edge edge);
         bool hasVertex(int vertex);
+        bool multigraph();
         Edge edgeAt(int index);
         Edge edgeAt(int source, int destination);
         int vertexAt(int index);
         int getNumEdges();
         int getNumVertex();
         int getEdgeIndex(Edge edge);
+        int getEdgeMultiplicity(int source, int destination);
         int getVertexIndex(int vertex);
         int getVertexDegree(int vertex);
+        int getVertexInDegree(int vertex);
+        int getVertexOutDegree(int vertex);
         int getNumVertexOddDegree(); 
         List<Edge> getEdgeList();
         List<int> getVertexList();
-        List<List<int>> getAdjacencyList();
+        RaggedArray<int> getAdjacencyList();
+        View<Edge> getEdgeView();
+        View<int> getVertexView();
+        View<int> getAdjacencyView(int vertexIndex);
+        View<int> getIncidentEdgeView(int vertexIndex);
+        View<int> getReverseAdjacencyView(int vertexIndex);
         List<int> getVertexAloneList();
-        List<List<int>> getDFSOrderLists();
-        List<List<int>> getBFSOrderLists();
+        RaggedArray<int> getDFSOrderLists();
+        RaggedArray<int> getBFSOrderLists();
         Graph getKruskalTree();
         Graph getPrimTree();
-        virtual bool directed();
+        Graph getBoruvkaForest();
+        List<int> getEulerianPath();
+        List<int> getCoreNumbers();
+        List<int> getParallelCoreNumbers();
+        Graph getKCore(int k);
+        bool directed();
         virtual bool connected(); 
         bool weighted(); 
         virtual bool haveCycle(); 
@@ -78,18 +174,27 @@ class Graph {
         void printFormatedData();
 
     protected:
-        List<Edge> edgeList;
-        List<int> vertexList;
-        List<List<int>> adjacencyMatrix;
-        List<List<int>> adjacencyList;
+        shared_ptr<GraphStorage> storage = make_shared<GraphStorage>();
+        GraphObserver* observer = nullptr;
+        void detach();
         void updateAdjacencyMatrix();
-        void updateAdjacencyList();
-        void DFS(int vertex, Graph graph, bool* visited);
-        bool DFSCycle(int vertex, Graph graph, bool* visited);
-        void DFSRecStack(int vertex, Graph graph, bool* visited, List<int>& recStack);
-        void BFSRecStack(int vertex, Graph graph, bool* visited, List<int>& recStack, List<int>& queue);
-
-    private:
+        void updateAdjacencyView();
+        void updateReverseAdjacencyView();
+        void updateDegreeLists();
+        void updateVertexIndex();
+        void onVertexListChange();
+        void onEdgeListChange();
+        void checkEdgeEndpoints(const List<Edge>& edgeList);
+        void removeEdgeOccurrences(const List<Edge>& requestList);
+        int getCoreDegree(int vertexIndex);
+        List<int> getVertexListOutsideCore(int k);
+        unsigned long long edgeKey(int source, int destination);
+        bool sameEdge(const Edge& edge, const Edge& other);
+        bool cachedQuery(GraphQuery query, int& result);
+        int storeQuery(GraphQuery query, int result);
+        void DFS(int vertexIndex, Graph& graph, bool* visited);
+        bool DFSCycle(int vertexIndex, int parentIndex, Graph& graph, bool* visited);
+        void DFSRecStack(int vertexIndex, Graph& graph, bool* visited, RaggedArray<int>& recStack);
         bool directGraph = false;
 };
 
@@ -108,10 +213,10 @@ Edge::Edge(int source, int destination, int weight) {
 
 // copy constructor
 Edge::Edge(const Edge& other) {
-    this->source = other.getSource();
-    this->destination = other.getDestination();
-    if (other.hasWeight())
-        this->setWeight(other.getWeight());
+    this->source = other.source;
+    this->destination = other.destination;
+    this->weight = other.weight;
+    this->weightDefined = other.weightDefined;
 } 
 
 // return edge source
@@ -136,18 +241,18 @@ void Edge::setDestination(int destination) {
 
 // set edge weight
 void Edge::setWeight(int weight) {
-    this->weight = new int;
-    *this->weight = weight;
+    this->weight = weight;
+    this->weightDefined = true;
 }
 
 // return true if edge has weight
 bool Edge::hasWeight() const {
-    return this->weight != nullptr;
+    return this->weightDefined;
 }
 
 // return edge weight
 int Edge::getWeight() const {
-    return *this->weight;
+    return this->weight;
 }
 
 // make edge reverse
@@ -195,11 +300,10 @@ bool Edge::operator>(const Edge& other) {
                                 
 Edge& Edge::operator=(const Edge& other) { 
     if (this != &other) {
-        this->source = other.getSource();
-        this->destination = other.getDestination();
-
-        if (other.hasWeight())
-            this->setWeight(other.getWeight());
+        this->source = other.source;
+        this->destination = other.destination;
+        this->weight = other.weight;
+        this->weightDefined = other.weightDefined;
     }
     return *this;
 }
@@ -215,14 +319,12 @@ ostream& operator<<(ostream& os, const Edge& edge) {
 }
 
 Graph::Graph(List<int> vertexList) {
-    this->vertexList = vertexList;
+    this->storage->vertexList = vertexList;
 }
 
 Graph::Graph(List<int> vertexList, List<Edge> edgeList) {
-    this->vertexList = vertexList;
-    
-    for (int i = 0; i < edgeList.size(); i++) 
-        this->addEdge(edgeList[i]);
+    this->storage->vertexList = vertexList;
+    this->addEdges(edgeList);
 }
 
 Graph::Graph(List<int> vertexList, List<Edge> edgeList, List<int> weightList) {
@@ -231,35 +333,30 @@ Graph::Graph(List<int> vertexList, List<Edge> edgeList, List<int> weightList) {
     if (weightList.size() != edgeList.size()) 
         throw e;
 
-    this->vertexList = vertexList;
+    this->storage->vertexList = vertexList;
 
-    for (int i = 0; i < edgeList.size(); i++) {
+    for (int i = 0; i < edgeList.size(); i++) 
         edgeList[i].setWeight(weightList[i]);
-        this->addEdge(edgeList[i]);
-    }
+
+    this->addEdges(edgeList);
 }
 
-Graph::Graph(Graph& other) {
-    if (this != &other)  {
-        this->directGraph = other.directed();
-        this->vertexList = other.getVertexList();
-        this->edgeList = other.getEdgeList();  
-    }
+// copy constructor, the storage is shared until one of the graphs changes
+Graph::Graph(const Graph& other) {
+    this->directGraph = other.directGraph;
+    this->storage = other.storage;
 }
 
+// move constructor, the other graph is left empty
 Graph::Graph(Graph&& other) {
-    if (this != &other)  {
-        this->directGraph = other.directGraph;
-        this->vertexList = other.vertexList;
-        this->edgeList = other.edgeList;   
-    }
+    this->directGraph = other.directGraph;
+    this->storage.swap(other.storage);
 }
 
-Graph& Graph::operator=(Graph& other) {
+Graph& Graph::operator=(const Graph& other) {
     if (this != &other)  {
-        this->directGraph = other.directed();
-        this->vertexList = other.getVertexList();
-        this->edgeList = other.getEdgeList();  
+        this->directGraph = other.directGraph;
+        this->storage = other.storage;
     }
 
     return *this;
@@ -268,38 +365,87 @@ Graph& Graph::operator=(Graph& other) {
 Graph&  Graph::operator=(Graph&& other) {
     if (this != &other)  {
         this->directGraph = other.directGraph;
-        this->vertexList = other.vertexList;
-        this->edgeList = other.edgeList;  
+        this->storage.swap(other.storage);
     }
 
     return *this;
 }
 
+// observe the mutations of this object, nullptr stops observing
+void Graph::setObserver(GraphObserver* observer) {
+    this->observer = observer;
+}
+
+// return the mutation counter, copies sharing the storage share it
+unsigned long Graph::getVersion() {
+    return this->storage->version;
+}
+
+QueryCacheStats& Graph::getQueryCacheStats() {
+    static QueryCacheStats stats;
+    return stats;
+}
+
+void Graph::printQueryCacheStats() {
+    QueryCacheStats& stats = Graph::getQueryCacheStats();
+
+    for (int i = 0; i < NUM_GRAPH_QUERIES; i++) 
+        if (stats.hits[i] + stats.misses[i] > 0) 
+            cout << graphQueryNames[i] << ": " << stats.hits[i] << " hits, " << stats.misses[i] << " misses" << endl;
+}
+
+// true and the stored result if the query already ran on this version
+bool Graph::cachedQuery(GraphQuery query, int& result) {
+    QueryCacheStats& stats = Graph::getQueryCacheStats();
+
+    if (this->storage->queryVersion[query] == this->storage->version + 1) {
+        stats.hits[query]++;
+        result = this->storage->queryResult[query];
+        return true;
+    }
+
+    stats.misses[query]++;
+    return false;
+}
+
+// keep the result for the current version and return it
+int Graph::storeQuery(GraphQuery query, int result) {
+    this->storage->queryVersion[query] = this->storage->version + 1;
+    this->storage->queryResult[query] = result;
+    return result;
+}
+
+// take a private copy of the storage before changing it
+void Graph::detach() {
+    if (this->storage.use_count() > 1)
+        this->storage = make_shared<GraphStorage>(*this->storage);
+}
+
 void Graph::printAdjacencyMatrix() {
     this->updateAdjacencyMatrix();
 
     cout << "  ";
-    for (int i = 0; i < this->vertexList.size(); i++) {
-        cout << this->vertexList[i] << " ";
+    for (int i = 0; i < this->storage->vertexList.size(); i++) {
+        cout << this->storage->vertexList[i] << " ";
     }
     cout << endl;
 
-    for (int i = 0; i < this->adjacencyMatrix.size(); i++) {
-        cout << this->vertexList[i] << " ";
-        for (int j = 0; j < this->adjacencyMatrix[i].size(); j++) {
-            cout << this->adjacencyMatrix[i][j] << " ";
+    for (int i = 0; i < this->storage->adjacencyMatrix.size(); i++) {
+        cout << this->storage->vertexList[i] << " ";
+        for (int j = 0; j < this->storage->adjacencyMatrix[i].size(); j++) {
+            cout << this->storage->adjacencyMatrix[i][j] << " ";
         }
         cout << endl;
     }
 }
 
 void Graph::printAdjacencyList() {
-    this->updateAdjacencyList();
+    for (int i = 0; i < this->storage->vertexList.size(); i++) {
+        View<int> adjacency = this->getAdjacencyView(i);
 
-    for (int i = 0; i < this->adjacencyList.size(); i++) {
-        cout << this->vertexList[i] << " -> ";
-        for (int j = 0; j < this->adjacencyList[i].size(); j++) {
-            cout << this->adjacencyList[i][j] << " ";
+        cout << this->storage->vertexList[i] << " -> ";
+        for (int j = 0; j < adjacency.size(); j++) {
+            cout << this->storage->vertexList[adjacency[j]] << " ";
         }
         cout << endl;
     }
@@ -308,17 +454,17 @@ void Graph::printAdjacencyList() {
 void Graph::printFormatedData() {
     cout << "V = {";
 
-    for (int i = 0; i < this->vertexList.size(); i++) {
-        cout << this->vertexList[i];
-        if (i != this->vertexList.size() - 1) 
+    for (int i = 0; i < this->storage->vertexList.size(); i++) {
+        cout << this->storage->vertexList[i];
+        if (i != this->storage->vertexList.size() - 1) 
             cout << ",";
     }
 
     cout << "}; A = {";
 
-    for (int i = 0; i < this->edgeList.size(); i++) {
-        cout << this->edgeList[i];
-        if (i != this->edgeList.size() - 1) 
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        cout << this->storage->edgeList[i];
+        if (i != this->storage->edgeList.size() - 1) 
             cout << ",";
     }
 
@@ -326,58 +472,333 @@ void Graph::printFormatedData() {
 }
 
 void Graph::updateAdjacencyMatrix() {
-    int matSize = this->vertexList.size();
+    int matSize = this->storage->vertexList.size();
     List<List<int>> newAdjacencyMatrix(matSize, List<int>(matSize, 0));
 
-    for (int i = 0; i < this->edgeList.size(); i++) {
-        int sourceIndex = this->vertexList.indexOf(this->edgeList[i].getSource());
-        int destinationIndex = this->vertexList.indexOf(this->edgeList[i].getDestination());
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        int sourceIndex = this->getVertexIndex(this->storage->edgeList[i].getSource());
+        int destinationIndex = this->getVertexIndex(this->storage->edgeList[i].getDestination());
 
         newAdjacencyMatrix[sourceIndex][destinationIndex]++;
+
+        if (!this->directed())
+            newAdjacencyMatrix[destinationIndex][sourceIndex]++;
     }
        
-    this->adjacencyMatrix = newAdjacencyMatrix;
+    this->storage->adjacencyMatrix = newAdjacencyMatrix;
+}
+
+// compact adjacency by vertex index, neighbors keep the edge list order
+// an undirected edge is listed under both endpoints, a self loop twice under its vertex
+void Graph::updateAdjacencyView() {
+    if (this->storage->adjacencyViewUpdated)
+        return;
+
+    int numVertex = this->storage->vertexList.size();
+    int numEdges = this->storage->edgeList.size();
+    int numEntries = this->directed() ? numEdges : 2 * numEdges;
+    vector<int>& offset = this->storage->adjacencyOffset;
+    vector<int> sourceIndex(numEdges), destinationIndex(numEdges);
+    vector<int> next;
+
+    offset.assign(numVertex + 1, 0);
+    this->storage->adjacencyIndex.resize(numEntries);
+    this->storage->adjacencyEdge.resize(numEntries);
+
+    for (int i = 0; i < numEdges; i++) {
+        sourceIndex[i] = this->getVertexIndex(this->storage->edgeList[i].getSource());
+        destinationIndex[i] = this->getVertexIndex(this->storage->edgeList[i].getDestination());
+
+        offset[sourceIndex[i] + 1]++;
+
+        if (!this->directed())
+            offset[destinationIndex[i] + 1]++;
+    }
+
+    for (int i = 0; i < numVertex; i++) 
+        offset[i + 1] += offset[i];
+
+    next.assign(offset.begin(), offset.end() - 1);
+
+    for (int i = 0; i < numEdges; i++) {
+        int position = next[sourceIndex[i]]++;
+
+        this->storage->adjacencyIndex[position] = destinationIndex[i];
+        this->storage->adjacencyEdge[position] = i;
+
+        if (!this->directed()) {
+            position = next[destinationIndex[i]]++;
+
+            this->storage->adjacencyIndex[position] = sourceIndex[i];
+            this->storage->adjacencyEdge[position] = i;
+        }
+    }
+
+    this->storage->adjacencyViewUpdated = true;
 }
 
-void Graph::updateAdjacencyList() {
-    int adjSize = this->vertexList.size();
-    List<List<int>> newAdjacencyList(adjSize, List<int>());
+// compact adjacency of the incoming edges, only built for digraphs
+void Graph::updateReverseAdjacencyView() {
+    if (this->storage->reverseAdjacencyViewUpdated)
+        return;
+
+    int numVertex = this->storage->vertexList.size();
+    int numEdges = this->storage->edgeList.size();
+    vector<int>& offset = this->storage->reverseAdjacencyOffset;
+    vector<int> next;
+
+    offset.assign(numVertex + 1, 0);
+    this->storage->reverseAdjacencyIndex.resize(numEdges);
+
+    for (int i = 0; i < numEdges; i++) 
+        offset[this->getVertexIndex(this->storage->edgeList[i].getDestination()) + 1]++;
+
+    for (int i = 0; i < numVertex; i++) 
+        offset[i + 1] += offset[i];
+
+    next.assign(offset.begin(), offset.end() - 1);
+
+    for (int i = 0; i < numEdges; i++) {
+        int position = next[this->getVertexIndex(this->storage->edgeList[i].getDestination())]++;
+        this->storage->reverseAdjacencyIndex[position] = this->getVertexIndex(this->storage->edgeList[i].getSource());
+    }
 
-    for (int i = 0; i < adjSize; i++) 
-        for (int j = 0; j < this->edgeList.size(); j++) 
-            if (this->vertexList[i] == this->edgeList[j].getSource()) 
-                newAdjacencyList[i].insert(this->edgeList[j].getDestination());
-        
-    this->adjacencyList = newAdjacencyList;
+    this->storage->reverseAdjacencyViewUpdated = true;
 }
 
+// undirected degrees are counted at both endpoints, so the in-degree is already the degree
 int Graph::getVertexDegree(int vertex) {
-    int count = 0;
+    if (this->directed())
+        return this->getVertexInDegree(vertex) + this->getVertexOutDegree(vertex);
 
-    for (int i = 0; i < this->edgeList.size(); i++) 
-        if (this->edgeList[i].getDestination() == vertex) 
-            count++;
+    return this->getVertexInDegree(vertex);
+}
 
-    return count;
+int Graph::getVertexInDegree(int vertex) {
+    int vertexIndex = this->getVertexIndex(vertex);
+
+    if (vertexIndex == -1)
+        return 0;
+
+    this->updateDegreeLists();
+    return this->storage->inDegreeList[vertexIndex];
+}
+
+int Graph::getVertexOutDegree(int vertex) {
+    int vertexIndex = this->getVertexIndex(vertex);
+
+    if (vertexIndex == -1)
+        return 0;
+
+    this->updateDegreeLists();
+    return this->storage->outDegreeList[vertexIndex];
+}
+
+// count in and out degrees of every vertex in one pass over the edges
+void Graph::updateDegreeLists() {
+    if (this->storage->degreeListsUpdated)
+        return;
+
+    int numVertex = this->storage->vertexList.size();
+    List<int> newInDegreeList(numVertex, 0);
+    List<int> newOutDegreeList(numVertex, 0);
+
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        int sourceIndex = this->getVertexIndex(this->storage->edgeList[i].getSource());
+        int destinationIndex = this->getVertexIndex(this->storage->edgeList[i].getDestination());
+
+        newOutDegreeList[sourceIndex]++;
+        newInDegreeList[destinationIndex]++;
+
+        // an undirected edge leaves and enters both of its endpoints
+        if (!this->directed()) {
+            newOutDegreeList[destinationIndex]++;
+            newInDegreeList[sourceIndex]++;
+        }
+    }
+
+    this->storage->inDegreeList = newInDegreeList;
+    this->storage->outDegreeList = newOutDegreeList;
+    this->storage->degreeListsUpdated = true;
+}
+
+// map each vertex to its position in the vertex list
+void Graph::updateVertexIndex() {
+    if (this->storage->vertexIndexUpdated)
+        return;
+
+    this->storage->vertexIndexMap.clear();
+    this->storage->vertexIndexMap.reserve(this->storage->vertexList.size());
+
+    for (int i = 0; i < this->storage->vertexList.size(); i++)
+        this->storage->vertexIndexMap.emplace(this->storage->vertexList[i], i);
+
+    this->storage->vertexIndexUpdated = true;
+}
+
+// drop every cache that depends on the vertex list
+void Graph::onVertexListChange() {
+    this->storage->version++;
+    this->storage->vertexIndexUpdated = false;
+    this->storage->degreeListsUpdated = false;
+    this->storage->adjacencyViewUpdated = false;
+    this->storage->reverseAdjacencyViewUpdated = false;
+}
+
+// drop every cache that depends on the edge list
+void Graph::onEdgeListChange() {
+    this->storage->version++;
+    this->storage->degreeListsUpdated = false;
+    this->storage->adjacencyViewUpdated = false;
+    this->storage->reverseAdjacencyViewUpdated = false;
+}
+
+// throw before anything changes if some edge has an unknown endpoint
+void Graph::checkEdgeEndpoints(const List<Edge>& edgeList) {
+    exception e;
+
+    for (int i = 0; i < edgeList.size(); i++) 
+        if (!this->hasVertex(edgeList[i].getSource()) or !this->hasVertex(edgeList[i].getDestination())) 
+            throw e;
+}
+
+// remove one stored edge per request in a single compaction pass, earlier edges match first
+void Graph::removeEdgeOccurrences(const List<Edge>& requestList) {
+    unordered_map<unsigned long long, vector<Edge>> pending;
+
+    auto key = [&](const Edge& edge) {
+        return this->edgeKey(edge.getSource(), edge.getDestination());
+    };
+
+    pending.reserve(requestList.size());
+
+    for (int i = 0; i < requestList.size(); i++) 
+        pending[key(requestList[i])].push_back(requestList[i]);
+
+    this->detach();
+    this->storage->edgeList.removeIf([&](const Edge& edge) {
+        auto it = pending.find(key(edge));
+
+        if (it == pending.end())
+            return false;
+
+        vector<Edge>& requests = it->second;
+
+        // same rule as edge equality, the weight only counts when both sides have one
+        for (int i = 0; i < (int) requests.size(); i++) {
+            if (!requests[i].hasWeight() or !edge.hasWeight() or requests[i].getWeight() == edge.getWeight()) {
+                requests.erase(requests.begin() + i);
+                return true;
+            }
+        }
+
+        return false;
+    });
+
+    this->onEdgeListChange();
+}
+
+// endpoints packed in one key, undirected edges are keyed the same both ways
+unsigned long long Graph::edgeKey(int source, int destination) {
+    if (!this->directed() and source > destination) {
+        int aux = source;
+        source = destination;
+        destination = aux;
+    }
+
+    return ((unsigned long long) (unsigned int) source << 32) | (unsigned int) destination;
+}
+
+// edge equality, an undirected edge also matches its reverse
+bool Graph::sameEdge(const Edge& edge, const Edge& other) {
+    Edge reverse = other;
+
+    if (Edge(edge) == other)
+        return true;
+
+    reverse.reverse();
+    return !this->directed() and Edge(edge) == reverse;
 }
 
 void Graph::removeVertex(int vertex) {
-    List<Edge> oldEdgeList = this->edgeList;
-    this->vertexList.remove(vertex);
+    this->removeVertices(List<int>(1, vertex));
+}
 
-    for (int i = 0; i < oldEdgeList.size(); i++) 
-        if (oldEdgeList[i].getSource() == vertex or oldEdgeList[i].getDestination() == vertex) 
-            this->edgeList.remove(oldEdgeList[i]);
+// move the vertex at index order[i] to index i, ids and edges are unchanged
+// only the internal indexes change, so the order is not reported to the observer
+void Graph::permuteVertices(const List<int>& order) {
+    int numVertex = this->getNumVertex();
+    vector<char> seen(numVertex, 0);
+    exception e;
+
+    if (order.size() != numVertex)
+        throw e;
+
+    for (int i = 0; i < numVertex; i++) {
+        if (order[i] < 0 or order[i] >= numVertex or seen[order[i]])
+            throw e;
+
+        seen[order[i]] = 1;
+    }
+
+    this->detach();
+
+    List<int> vertexList(numVertex, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        vertexList[i] = this->storage->vertexList[order[i]];
+
+    this->storage->vertexList = move(vertexList);
+    this->onVertexListChange();
+}
+
+// remove many vertices and their edges, the vertex and edge lists are compacted once
+void Graph::removeVertices(const List<int>& vertexList) {
+    int numVertex = this->getNumVertex();
+    vector<char> removed(numVertex, 0);
+
+    for (int i = 0; i < vertexList.size(); i++) {
+        int vertexIndex = this->getVertexIndex(vertexList[i]);
+
+        if (vertexIndex != -1)
+            removed[vertexIndex] = 1;
+    }
+
+    this->detach();
+
+    // the index map is still valid until the vertex list change is published
+    this->storage->edgeList.removeIf([&](const Edge& edge) {
+        return removed[this->getVertexIndex(edge.getSource())] or removed[this->getVertexIndex(edge.getDestination())];
+    });
+
+    this->storage->vertexList.removeIf([&](int vertex) {
+        return removed[this->getVertexIndex(vertex)] != 0;
+    });
+
+    this->onVertexListChange();
+
+    if (this->observer != nullptr)
+        this->observer->onRemoveVertices(View<int>(vertexList.data(), vertexList.data() + vertexList.size()));
 }
 
 bool Graph::hasEdge(Edge edge) {
-    return this->edgeList.has(edge);
+    return this->getEdgeIndex(edge) != -1;
 }
 
+// remove one copy of the edge, stored in either direction
 void Graph::removeEdge(Edge edge) {
-    this->edgeList.remove(edge);
-    edge.reverse();
-    this->edgeList.remove(edge);
+    this->removeEdgeOccurrences(List<Edge>(1, edge));
+
+    if (this->observer != nullptr)
+        this->observer->onRemoveEdges(View<Edge>(&edge, &edge + 1));
+}
+
+// remove one copy of each edge, in a single pass
+void Graph::removeEdges(const List<Edge>& edgeList) {
+    this->removeEdgeOccurrences(edgeList);
+
+    if (this->observer != nullptr)
+        this->observer->onRemoveEdges(View<Edge>(edgeList.data(), edgeList.data() + edgeList.size()));
 }
 
 void Graph::addEdge(Edge edge) {
@@ -386,174 +807,315 @@ void Graph::addEdge(Edge edge) {
     if (!this->hasVertex(edge.getSource()) or !this->hasVertex(edge.getDestination())) 
         throw e;
 
-    this->edgeList.insert(edge);
-    edge.reverse();
-    this->edgeList.insert(edge);
+    this->detach();
+    this->storage->edgeList.insert(edge);
+    this->onEdgeListChange();
+
+    if (this->observer != nullptr)
+        this->observer->onAddEdges(View<Edge>(&edge, &edge + 1));
+}
+
+// add many edges, the graph is left untouched if any of them is invalid
+void Graph::addEdges(const List<Edge>& edgeList) {
+    this->checkEdgeEndpoints(edgeList);
+    this->detach();
+    this->storage->edgeList.reserve(this->storage->edgeList.size() + edgeList.size());
+
+    for (int i = 0; i < edgeList.size(); i++) 
+        this->storage->edgeList.insert(edgeList[i]);
+
+    this->onEdgeListChange();
+
+    if (this->observer != nullptr)
+        this->observer->onAddEdges(View<Edge>(edgeList.data(), edgeList.data() + edgeList.size()));
 }
 
 void Graph::addVertex(int vertex) {
-    this->vertexList.insert(vertex);
+    this->detach();
+    this->storage->vertexList.insert(vertex);
+    this->onVertexListChange();
+
+    if (this->observer != nullptr)
+        this->observer->onAddVertex(vertex);
 }
 
 bool Graph::hasVertex(int vertex) {
-    return this->vertexList.has(vertex);
+    return this->getVertexIndex(vertex) != -1;
 }
 
 int Graph::getNumVertex() {
-    return this->vertexList.size();
+    return this->storage->vertexList.size();
 }
 
 int Graph::vertexAt(int index) {
-    return this->vertexList[index];
+    return this->storage->vertexList[index];
 }
 
 int Graph::getNumEdges() {
-    return this->edgeList.size();
+    return this->storage->edgeList.size();
 }
 
 Edge Graph::edgeAt(int index) {
-    return this->edgeList[index];
+    return this->storage->edgeList[index];
 }
 
+// an undirected edge stored the other way is returned as asked
 Edge Graph::edgeAt(int source, int destination) {
-    for (int i = 0; i < this->edgeList.size(); i++) {
-        Edge edge = this->edgeList[i];
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        Edge edge = this->storage->edgeList[i];
 
         if (edge.getSource() == source and edge.getDestination() == destination) 
             return edge;
+
+        if (!this->directed() and edge.getSource() == destination and edge.getDestination() == source) {
+            edge.reverse();
+            return edge;
+        }
     }
 
     throw runtime_error("this edge does not exists");
 }
 
+// position of the first stored copy of the edge, -1 if there is none
 int Graph::getEdgeIndex(Edge edge) {
-    return this->edgeList.indexOf(edge);
+    for (int i = 0; i < this->storage->edgeList.size(); i++) 
+        if (this->sameEdge(this->storage->edgeList[i], edge)) 
+            return i;
+
+    return -1;
+}
+
+// number of parallel edges between the two vertex, in either direction for undirected graphs
+int Graph::getEdgeMultiplicity(int source, int destination) {
+    unsigned long long key = this->edgeKey(source, destination);
+    int count = 0;
+
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        const Edge& edge = this->storage->edgeList[i];
+
+        if (this->edgeKey(edge.getSource(), edge.getDestination()) == key)
+            count++;
+    }
+
+    return count;
+}
+
+// true if some pair of vertex has more than one edge between them
+bool Graph::multigraph() {
+    unordered_map<unsigned long long, int> seen;
+    int result;
+
+    if (this->cachedQuery(QUERY_MULTIGRAPH, result))
+        return result;
+
+    seen.reserve(this->storage->edgeList.size());
+
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        const Edge& edge = this->storage->edgeList[i];
+
+        if (seen[this->edgeKey(edge.getSource(), edge.getDestination())]++ > 0)
+            return this->storeQuery(QUERY_MULTIGRAPH, true);
+    }
+
+    return this->storeQuery(QUERY_MULTIGRAPH, false);
 }
 
 int Graph::getVertexIndex(int vertex) {
-    return this->vertexList.indexOf(vertex);
+    this->updateVertexIndex();
+
+    unordered_map<int, int>::iterator it = this->storage->vertexIndexMap.find(vertex);
+
+    if (it == this->storage->vertexIndexMap.end())
+        return -1;
+
+    return it->second;
 }
 
 bool Graph::directed() {
     return this->directGraph;
 }
 
-List<List<int>> Graph::getAdjacencyList() {
-    this->updateAdjacencyList();
-    return this->adjacencyList;
+// one row of neighbor ids per vertex, in vertex list order
+RaggedArray<int> Graph::getAdjacencyList() {
+    this->updateAdjacencyView();
+
+    int numVertex = this->storage->vertexList.size();
+    RaggedArray<int> adjacencyList(numVertex, this->storage->adjacencyIndex.size());
+
+    for (int i = 0; i < numVertex; i++) {
+        View<int> adjacency = this->getAdjacencyView(i);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            adjacencyList.append(this->storage->vertexList[adjacency[j]]);
+
+        adjacencyList.endRow();
+    }
+
+    return adjacencyList;
 }
 
 List<Edge> Graph::getEdgeList() {
-    return this->edgeList;
+    return this->storage->edgeList;
 }
 
 List<int> Graph::getVertexList() {
-    return this->vertexList;
+    return this->storage->vertexList;
+}
+
+// read only edges, no copy
+View<Edge> Graph::getEdgeView() {
+    Edge* first = this->storage->edgeList.data();
+    return View<Edge>(first, first + this->storage->edgeList.size());
+}
+
+// read only vertex, no copy
+View<int> Graph::getVertexView() {
+    int* first = this->storage->vertexList.data();
+    return View<int>(first, first + this->storage->vertexList.size());
+}
+
+// indexes of the vertex adjacent to the one at vertexIndex
+View<int> Graph::getAdjacencyView(int vertexIndex) {
+    this->updateAdjacencyView();
+
+    int* first = this->storage->adjacencyIndex.data();
+    return View<int>(first + this->storage->adjacencyOffset[vertexIndex], first + this->storage->adjacencyOffset[vertexIndex + 1]);
+}
+
+// positions in the edge view of the edges leaving the vertex at vertexIndex, aligned with its adjacency view
+View<int> Graph::getIncidentEdgeView(int vertexIndex) {
+    this->updateAdjacencyView();
+
+    int* first = this->storage->adjacencyEdge.data();
+    return View<int>(first + this->storage->adjacencyOffset[vertexIndex], first + this->storage->adjacencyOffset[vertexIndex + 1]);
+}
+
+// indexes of the vertex with an edge into the one at vertexIndex
+// the adjacency of an undirected graph is symmetric, so it is the adjacency view itself
+View<int> Graph::getReverseAdjacencyView(int vertexIndex) {
+    if (!this->directed())
+        return this->getAdjacencyView(vertexIndex);
+
+    this->updateReverseAdjacencyView();
+
+    int* first = this->storage->reverseAdjacencyIndex.data();
+    return View<int>(first + this->storage->reverseAdjacencyOffset[vertexIndex], first + this->storage->reverseAdjacencyOffset[vertexIndex + 1]);
 }
 
 bool Graph::weighted() {
-    if (this->edgeList.empty()) 
-        return false;
+    int result;
+
+    if (this->cachedQuery(QUERY_WEIGHTED, result))
+        return result;
 
-    return this->edgeList[0].hasWeight();
+    if (this->storage->edgeList.empty()) 
+        return this->storeQuery(QUERY_WEIGHTED, false);
+
+    return this->storeQuery(QUERY_WEIGHTED, this->storage->edgeList[0].hasWeight());
 }
 
 bool Graph::connected() {
-    Graph graph = *this;
-    int numVertex = graph.getNumVertex();
+    int numVertex = this->getNumVertex();
+    int result;
+
+    if (this->cachedQuery(QUERY_CONNECTED, result))
+        return result;
+
+    if (numVertex == 0)
+        return this->storeQuery(QUERY_CONNECTED, true);
+
     bool visited[numVertex];
 
     for (int i = 0; i < numVertex; i++) 
         visited[i] = false;
 
-    this->DFS(graph.vertexAt(0), graph, visited);
+    this->DFS(0, *this, visited);
 
     for (int i = 0; i < numVertex; i++) 
         if (!visited[i]) 
-            return false;
+            return this->storeQuery(QUERY_CONNECTED, false);
 
-    return true;
+    return this->storeQuery(QUERY_CONNECTED, true);
 }
 
-void Graph::DFS(int vertex, Graph graph, bool* visited) {
-    int vertexIndex = graph.getVertexIndex(vertex);
-
-    List<int> vertexList = graph.getAdjacencyList()[vertexIndex];
+void Graph::DFS(int vertexIndex, Graph& graph, bool* visited) {
+    View<int> adjacency = graph.getAdjacencyView(vertexIndex);
 
     visited[vertexIndex] = true;
 
-    for (int i = 0; i < vertexList.size(); i++) {
-        int adjIndex, adjVertex;
-
-        adjVertex = vertexList[i];
-        adjIndex = graph.getVertexIndex(adjVertex);
-
-        if (!visited[adjIndex]) 
-            this->DFS(adjVertex, graph, visited);
-    }
+    for (int i = 0; i < adjacency.size(); i++) 
+        if (!visited[adjacency[i]]) 
+            this->DFS(adjacency[i], graph, visited);
 }
 
 int Graph::getNumVertexOddDegree() {
     int count = 0;
 
-    for (int i = 0; i < this->vertexList.size(); i++) 
-        if (this->getVertexDegree(this->vertexList[i]) % 2 != 0) 
+    if (this->cachedQuery(QUERY_ODD_DEGREE, count))
+        return count;
+
+    for (int i = 0; i < this->storage->vertexList.size(); i++) 
+        if (this->getVertexDegree(this->storage->vertexList[i]) % 2 != 0) 
             count++;
 
-    return count;
+    return this->storeQuery(QUERY_ODD_DEGREE, count);
 }
 
 List<int> Graph::getVertexAloneList() {
     List<int> aloneVertexList;
-    bool exist;
+    int result;
 
-    for (int i = 0; i < this->vertexList.size(); i++) {
-        exist = false;
+    if (this->cachedQuery(QUERY_ALONE_VERTEX, result))
+        return this->storage->aloneVertexList;
 
-        for (int j = 0; j < this->edgeList.size(); j++) 
-            if (this->vertexList[i] == this->edgeList[j].getSource() or this->vertexList[i] == this->edgeList[j].getDestination()) 
-                exist = true;
+    this->updateDegreeLists();
 
-        if (!exist) 
-            aloneVertexList.insert(this->vertexList[i]);
-    }    
+    for (int i = 0; i < this->storage->vertexList.size(); i++) 
+        if (this->storage->inDegreeList[i] == 0 and this->storage->outDegreeList[i] == 0) 
+            aloneVertexList.insert(this->storage->vertexList[i]);
 
+    this->storage->aloneVertexList = aloneVertexList;
+    this->storeQuery(QUERY_ALONE_VERTEX, aloneVertexList.size());
     return aloneVertexList;
 }
 
 bool Graph::haveCycle() {
-    Graph graph = *this;
-    int numVertex = graph.getNumVertex();
+    int numVertex = this->getNumVertex();
+    int result;
+
+    if (this->cachedQuery(QUERY_HAVE_CYCLE, result))
+        return result;
+
     bool visited[numVertex];
 
     for (int i = 0; i < numVertex; i++) 
         visited[i] = false;
 
-    for (int i = 0; i < numVertex; i++) {
-        int vertex = graph.vertexAt(i);
-
+    for (int i = 0; i < numVertex; i++) 
         if (!visited[i]) 
-            if (this->DFSCycle(vertex, graph, visited)) 
-                return true;
-    }
+            if (this->DFSCycle(i, -1, *this, visited)) 
+                return this->storeQuery(QUERY_HAVE_CYCLE, true);
 
-    return false;
+    return this->storeQuery(QUERY_HAVE_CYCLE, false);
 }
 
-bool Graph::DFSCycle(int vertex, Graph graph, bool* visited) {
-    int vertexIndex = graph.getVertexIndex(vertex);
-    List<int> vertexList = graph.getAdjacencyList()[vertexIndex];
+// the edge back to the parent is skipped once, a parallel copy of it is a cycle
+bool Graph::DFSCycle(int vertexIndex, int parentIndex, Graph& graph, bool* visited) {
+    View<int> adjacency = graph.getAdjacencyView(vertexIndex);
+    bool parentSkipped = false;
 
     visited[vertexIndex] = true;
 
-    for (int i = 0; i < vertexList.size(); i++) {
-        int adjVertex = vertexList[i];
-        int adjVertexIndex = graph.getVertexIndex(adjVertex);
+    for (int i = 0; i < adjacency.size(); i++) {
+        int adjIndex = adjacency[i];
 
-        if (!visited[adjVertexIndex]) {
-            graph.removeEdge(Edge(adjVertex, vertex));
+        if (adjIndex == parentIndex and !parentSkipped) {
+            parentSkipped = true;
+            continue;
+        }
 
-            if (this->DFSCycle(adjVertex, graph, visited)) 
+        if (!visited[adjIndex]) {
+            if (this->DFSCycle(adjIndex, vertexIndex, graph, visited)) 
                 return true;
         } else {
             return true;
@@ -563,11 +1125,10 @@ bool Graph::DFSCycle(int vertex, Graph graph, bool* visited) {
     return false;
 }
 
-List<List<int>> Graph::getDFSOrderLists() {
-    List<List<int>> recStackList;
-    List<int> recStack;
-    Graph graph = *this;
-    int numVertex = graph.getNumVertex();
+// one row per dfs tree, every row lives in the same arena
+RaggedArray<int> Graph::getDFSOrderLists() {
+    int numVertex = this->getNumVertex();
+    RaggedArray<int> recStackList(numVertex, numVertex);
     bool visited[numVertex];
     
     for (int i = 0; i < numVertex; i++) 
@@ -575,87 +1136,70 @@ List<List<int>> Graph::getDFSOrderLists() {
 
     for (int i = 0; i < numVertex; i++) {
         if (!visited[i]) {
-            this->DFSRecStack(graph.vertexAt(i), graph, visited, recStack);
-            recStack.reverse();
-            recStackList.insert(recStack);
-            recStack.clear();
+            this->DFSRecStack(i, *this, visited, recStackList);
+            recStackList.endRow();
+            recStackList.reverseRow(recStackList.size() - 1);
         }
     } 
 
     return recStackList;
 }
 
-void Graph::DFSRecStack(int vertex, Graph graph, bool* visited, List<int>& recStack) {
-    int vertexIndex = graph.getVertexIndex(vertex);
-
-    List<int> adjVertexList = graph.getAdjacencyList()[vertexIndex];
+// append the post order of the vertex to the row being built
+void Graph::DFSRecStack(int vertexIndex, Graph& graph, bool* visited, RaggedArray<int>& recStack) {
+    View<int> adjacency = graph.getAdjacencyView(vertexIndex);
 
     visited[vertexIndex] = true;
 
-    for (int i = 0; i < adjVertexList.size(); i++) {
-        int adjVertex = adjVertexList[i];
-        int adjVertexIndex = graph.getVertexIndex(adjVertex);
+    for (int i = 0; i < adjacency.size(); i++) 
+        if (!visited[adjacency[i]])
+            this->DFSRecStack(adjacency[i], graph, visited, recStack);
 
-        if (!visited[adjVertexIndex])
-            this->DFSRecStack(adjVertex, graph, visited, recStack);
-    }
-
-    recStack.insert(vertex);
+    recStack.append(graph.vertexAt(vertexIndex));
 }
 
-List<List<int>> Graph::getBFSOrderLists() {
-    List<List<int>> recStackList;
-    List<int> queue;
-    List<int> recStack;
-
-    Graph graph = *this;
-    int numVertex = graph.getNumVertex();
+// one row per bfs tree, the queue is an index array over the visit order
+RaggedArray<int> Graph::getBFSOrderLists() {
+    int numVertex = this->getNumVertex();
+    RaggedArray<int> recStackList(numVertex, numVertex);
+    vector<int> queue(numVertex);
     bool visited[numVertex];
     
     for (int i = 0; i < numVertex; i++) 
         visited[i] = false;
 
-    for (int i = 0; i < graph.getNumVertex(); i++) {
-        if (!visited[i]) {
-            this->BFSRecStack(graph.vertexAt(i), graph, visited, recStack, queue);
-            recStack.reverse();
-            recStackList.insert(recStack);
-            recStack.clear();
-        }
-    } 
-
-    return recStackList;
-}
+    for (int i = 0; i < numVertex; i++) {
+        if (visited[i])
+            continue;
 
-void Graph::BFSRecStack(int vertex, Graph graph, bool* visited, List<int>& recStack, List<int>& queue) {
-    int vertexIndex = graph.getVertexIndex(vertex);
+        int head = 0, tail = 0;
 
-    List<int> vertexList = graph.getAdjacencyList()[vertexIndex];
+        queue[tail++] = i;
+        visited[i] = true;
 
-    visited[vertexIndex] = true;
+        while (head < tail) {
+            int vertexIndex = queue[head++];
+            View<int> adjacency = this->getAdjacencyView(vertexIndex);
 
-    for (int i = 0; i < vertexList.size(); i++) {
-        int adjVertex = vertexList[i];
-        int adjVertexIndex = graph.getVertexIndex(adjVertex);
+            recStackList.append(this->vertexAt(vertexIndex));
 
-        if (!visited[adjVertexIndex]) {
-            visited[adjVertexIndex] = true;
-            queue.insert(adjVertex);
+            for (int j = 0; j < adjacency.size(); j++) {
+                if (!visited[adjacency[j]]) {
+                    visited[adjacency[j]] = true;
+                    queue[tail++] = adjacency[j];
+                }
+            }
         }
-    }
 
-    while (!queue.empty()) {
-        int nextVisitVertex = queue.removeFirst();
-        int nextVisitVertexIndex = graph.getVertexIndex(nextVisitVertex);
-        this->BFSRecStack(nextVisitVertex, graph, visited, recStack, queue);
-    }
+        recStackList.endRow();
+    } 
 
-    recStack.insert(vertex);
+    return recStackList;
 }
 
 Graph Graph::getKruskalTree() {
-    Graph kruskal(this->vertexList);
-    List<Edge> edgeList = this->edgeList;
+    Graph kruskal(this->storage->vertexList);
+    List<Edge> edgeList = this->storage->edgeList;
 
     edgeList.sort();
     
@@ -671,51 +1215,492 @@ Graph Graph::getKruskalTree() {
 }
 
 Graph Graph::getPrimTree() {
-    List<int> queue = this->vertexList;
-    int key[this->vertexList.size()];
-    int parents[this->vertexList.size()];
-    int u, v;
+    int numVertex = this->storage->vertexList.size();
+    View<Edge> edges = this->getEdgeView();
+    int key[numVertex];
+    int parents[numVertex];
+    bool queued[numVertex];
 
-    for (int i = 0; i <  this->vertexList.size(); i++) {
+    for (int i = 0; i < numVertex; i++) {
         key[i] = 9999999;
         parents[i] = -1;
+        queued[i] = true;
     }
 
     key[0] = 0;
 
-    while (!queue.empty()) {
-        int minKeyIndex = 0;
-
-        for (int i = 0; i < queue.size(); i++) {
-            int index = this->vertexList.indexOf(queue[i]);
+    for (int round = 0; round < numVertex; round++) {
+        int u = -1;
 
-            if (key[index] < key[this->vertexList.indexOf(queue[minKeyIndex])]) 
-                minKeyIndex = i;
-        }
+        for (int i = 0; i < numVertex; i++) 
+            if (queued[i] and (u == -1 or key[i] < key[u])) 
+                u = i;
 
-        u = queue[minKeyIndex];
-        queue.remove(u);
+        queued[u] = false;
 
-        List<int> adj = this->getAdjacencyList()[this->vertexList.indexOf(u)];
+        View<int> adjacency = this->getAdjacencyView(u);
+        View<int> incident = this->getIncidentEdgeView(u);
 
-        for (int i = 0; i < adj.size(); i++) {
-            v = adj[i];
-            int vIndex = this->vertexList.indexOf(v);
-            Edge edge = this->edgeAt(u, v);
-            int weight = edge.getWeight();
+        for (int i = 0; i < adjacency.size(); i++) {
+            int v = adjacency[i];
+            int weight = edges[incident[i]].getWeight();
 
-            if (queue.has(v) and weight < key[vIndex]) {
-                parents[vIndex] = u;
-                key[vIndex] = weight;
+            if (queued[v] and weight < key[v]) {
+                parents[v] = this->storage->vertexList[u];
+                key[v] = weight;
             }
         }   
     }
 
-    Graph prim(this->vertexList);
+    Graph prim(this->storage->vertexList);
 
-    for (int i = 0; i < this->vertexList.size(); i++) 
+    for (int i = 0; i < this->storage->vertexList.size(); i++) 
         if (parents[i] != -1) 
-            prim.addEdge(Edge(parents[i], this->vertexList[i], key[i]));
+            prim.addEdge(Edge(parents[i], this->storage->vertexList[i], key[i]));
 
     return prim;
 }
+
+// parallel boruvka, return the minimum spanning forest covering every component
+Graph Graph::getBoruvkaForest() {
+    struct BoruvkaEdge {
+        int source;
+        int destination;
+        int weight;
+        unsigned int id;
+    };
+
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = this->getNumVertex();
+    bool weighted = this->weighted();
+    vector<BoruvkaEdge> edges, nextEdges;
+    vector<Edge*> edgeOrigin;
+
+    // self loops never join a forest
+    for (int i = 0; i < this->storage->edgeList.size(); i++) {
+        Edge& edge = this->storage->edgeList[i];
+        int sourceIndex = this->getVertexIndex(edge.getSource());
+        int destinationIndex = this->getVertexIndex(edge.getDestination());
+
+        if (sourceIndex == destinationIndex)
+            continue;
+
+        edges.push_back({sourceIndex, destinationIndex, weighted ? edge.getWeight() : 1, (unsigned int) edgeOrigin.size()});
+        edgeOrigin.push_back(&edge);
+    }
+
+    // vertex indexes are the initial component labels
+    const unsigned long long none = ~0ULL;
+    vector<atomic<unsigned long long>> cheapest(numVertex);
+    vector<int> parent(numVertex), newLabel(numVertex);
+    vector<unsigned int> forestEdges;
+
+    for (int i = 0; i < numVertex; i++)
+        parent[i] = i;
+
+    while (!edges.empty()) {
+        pool.parallelFor(0, numVertex, [&](long begin, long end, int) {
+            for (long i = begin; i < end; i++)
+                cheapest[i].store(none, memory_order_relaxed);
+        });
+
+        // cheapest edge leaving each component, ties broken by edge id
+        pool.parallelFor(0, edges.size(), [&](long begin, long end, int) {
+            for (long i = begin; i < end; i++) {
+                unsigned long long key = ((unsigned long long) ((unsigned int) edges[i].weight ^ 0x80000000u) << 32) | edges[i].id;
+                int endpoints[2] = {edges[i].source, edges[i].destination};
+
+                for (int j = 0; j < 2; j++) {
+                    unsigned long long current = cheapest[endpoints[j]].load(memory_order_relaxed);
+
+                    while (key < current and !cheapest[endpoints[j]].compare_exchange_weak(current, key, memory_order_relaxed));
+                }
+            }
+        });
+
+        // hook components along their cheapest edges
+        for (int c = 0; c < numVertex; c++) {
+            unsigned long long key = cheapest[c].load(memory_order_relaxed);
+
+            if (key == none)
+                continue;
+
+            unsigned int id = key & 0xffffffffu;
+            int a = this->getVertexIndex(edgeOrigin[id]->getSource());
+            int b = this->getVertexIndex(edgeOrigin[id]->getDestination());
+
+            while (parent[a] != a) a = parent[a] = parent[parent[a]];
+            while (parent[b] != b) b = parent[b] = parent[parent[b]];
+
+            if (a != b) {
+                parent[a] = b;
+                forestEdges.push_back(id);
+            }
+        }
+
+        for (int c = 0; c < numVertex; c++) {
+            int root = c;
+
+            while (parent[root] != root)
+                root = parent[root];
+
+            newLabel[c] = root;
+        }
+
+        // contract, relabel endpoints and drop edges now inside one component
+        long numBlocks = pool.size() * 4;
+        long blockSize = (edges.size() + numBlocks - 1) / numBlocks;
+        vector<long> blockOffset(numBlocks + 1, 0);
+
+        pool.parallelFor(0, numBlocks, 1, [&](long begin, long end, int) {
+            for (long block = begin; block < end; block++) {
+                long count = 0;
+
+                for (long i = block * blockSize; i < min((long) edges.size(), (block + 1) * blockSize); i++) {
+                    edges[i].source = newLabel[edges[i].source];
+                    edges[i].destination = newLabel[edges[i].destination];
+                    count += edges[i].source != edges[i].destination;
+                }
+
+                blockOffset[block + 1] = count;
+            }
+        });
+
+        for (long block = 0; block < numBlocks; block++)
+            blockOffset[block + 1] += blockOffset[block];
+
+        nextEdges.resize(blockOffset[numBlocks]);
+
+        pool.parallelFor(0, numBlocks, 1, [&](long begin, long end, int) {
+            for (long block = begin; block < end; block++) {
+                long position = blockOffset[block];
+
+                for (long i = block * blockSize; i < min((long) edges.size(), (block + 1) * blockSize); i++)
+                    if (edges[i].source != edges[i].destination)
+                        nextEdges[position++] = edges[i];
+            }
+        });
+
+        edges.swap(nextEdges);
+    }
+
+    Graph forest(this->storage->vertexList);
+    List<Edge> forestEdgeList(forestEdges.size(), Edge());
+
+    for (int i = 0; i < (int) forestEdges.size(); i++) 
+        forestEdgeList[i] = *edgeOrigin[forestEdges[i]];
+
+    forest.storage->edgeList = forestEdgeList;
+    forest.onEdgeListChange();
+
+    return forest;
+}
+
+// hierholzer, return the vertex sequence of an eulerian circuit or path, empty if there is none
+List<int> Graph::getEulerianPath() {
+    int numVertex = this->getNumVertex();
+    bool directed = this->directed();
+    int startIndex = -1;
+    int numOdd = 0, numStart = 0, numEnd = 0;
+
+    if (numVertex == 0)
+        return List<int>();
+
+    this->updateDegreeLists();
+
+    // degree conditions, the start is the vertex with the extra exit edge
+    for (int i = 0; i < numVertex; i++) {
+        if (directed) {
+            int balance = this->storage->outDegreeList[i] - this->storage->inDegreeList[i];
+
+            if (balance == 1) {
+                numStart++;
+                startIndex = i;
+            } else if (balance == -1) {
+                numEnd++;
+            } else if (balance != 0) {
+                return List<int>();
+            }
+        } else if (this->storage->inDegreeList[i] % 2 != 0) {
+            if (numOdd++ == 0)
+                startIndex = i;
+        }
+    }
+
+    if (directed and !(numStart == 0 and numEnd == 0) and !(numStart == 1 and numEnd == 1))
+        return List<int>();
+
+    if (!directed and numOdd != 0 and numOdd != 2)
+        return List<int>();
+
+    for (int i = 0; startIndex == -1 and i < numVertex; i++)
+        if (this->storage->outDegreeList[i] > 0)
+            startIndex = i;
+
+    // no edges, the circuit is a single vertex
+    if (startIndex == -1) {
+        List<int> path;
+        path.insert(this->storage->vertexList[0]);
+        return path;
+    }
+
+    // edges by index
+    int numEdges = this->storage->edgeList.size();
+    vector<int> edgeSource(numEdges), edgeDestination(numEdges);
+
+    for (int i = 0; i < numEdges; i++) {
+        edgeSource[i] = this->getVertexIndex(this->storage->edgeList[i].getSource());
+        edgeDestination[i] = this->getVertexIndex(this->storage->edgeList[i].getDestination());
+    }
+
+    // compact adjacency of edge ids, both endpoints see an undirected edge
+    vector<int> offset(numVertex + 1, 0);
+
+    for (int e = 0; e < numEdges; e++) {
+        offset[edgeSource[e] + 1]++;
+        if (!directed) offset[edgeDestination[e] + 1]++;
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        offset[i + 1] += offset[i];
+
+    vector<int> next(offset.begin(), offset.end() - 1);
+    vector<int> adjEdge(offset[numVertex]), adjTarget(offset[numVertex]);
+
+    for (int e = 0; e < numEdges; e++) {
+        adjEdge[next[edgeSource[e]]] = e;
+        adjTarget[next[edgeSource[e]]++] = edgeDestination[e];
+
+        if (!directed) {
+            adjEdge[next[edgeDestination[e]]] = e;
+            adjTarget[next[edgeDestination[e]]++] = edgeSource[e];
+        }
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        next[i] = offset[i];
+
+    // walk unused edges, closing sub-circuits into the tour as the stack unwinds
+    vector<char> used(numEdges, 0);
+    vector<int> stack, tour;
+    stack.push_back(startIndex);
+
+    while (!stack.empty()) {
+        int v = stack.back();
+
+        while (next[v] < offset[v + 1] and used[adjEdge[next[v]]])
+            next[v]++;
+
+        if (next[v] == offset[v + 1]) {
+            tour.push_back(v);
+            stack.pop_back();
+        } else {
+            used[adjEdge[next[v]]] = 1;
+            stack.push_back(adjTarget[next[v]++]);
+        }
+    }
+
+    // edges left out of the walk belong to another component
+    if ((int) tour.size() != numEdges + 1)
+        return List<int>();
+
+    List<int> path(tour.size(), 0);
+
+    for (int i = 0; i < (int) tour.size(); i++)
+        path[i] = this->storage->vertexList[tour[tour.size() - 1 - i]];
+
+    return path;
+}
+
+// edges at the vertex at vertexIndex for the core decomposition, both directions of a digraph
+// parallel edges count once each, self loops do not count
+int Graph::getCoreDegree(int vertexIndex) {
+    View<int> adjacency = this->getAdjacencyView(vertexIndex);
+    int degree = 0;
+
+    for (int i = 0; i < adjacency.size(); i++)
+        degree += adjacency[i] != vertexIndex;
+
+    if (this->directed()) {
+        View<int> reverseAdjacency = this->getReverseAdjacencyView(vertexIndex);
+
+        for (int i = 0; i < reverseAdjacency.size(); i++)
+            degree += reverseAdjacency[i] != vertexIndex;
+    }
+
+    return degree;
+}
+
+// core number of every vertex by index, the largest k of a k-core holding it
+// batagelj-zaversnik: vertex kept sorted by current degree in bins, the lowest one is removed
+// and its neighbors move one bin down, O(V + E)
+List<int> Graph::getCoreNumbers() {
+    int numVertex = this->getNumVertex();
+    vector<int> degree(numVertex), order(numVertex), position(numVertex);
+    int maxDegree = 0;
+
+    for (int i = 0; i < numVertex; i++) {
+        degree[i] = this->getCoreDegree(i);
+        maxDegree = max(maxDegree, degree[i]);
+    }
+
+    // first position of each degree in the order
+    vector<int> bin(maxDegree + 2, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        bin[degree[i] + 1]++;
+
+    for (int d = 0; d <= maxDegree; d++)
+        bin[d + 1] += bin[d];
+
+    for (int i = 0; i < numVertex; i++) {
+        position[i] = bin[degree[i]]++;
+        order[position[i]] = i;
+    }
+
+    for (int d = maxDegree; d > 0; d--)
+        bin[d] = bin[d - 1];
+
+    bin[0] = 0;
+
+    auto lower = [&](int u, int v) {
+        if (u == v or degree[u] <= degree[v])
+            return;
+
+        // swap u with the first vertex of its bin, then that bin starts one later
+        int first = bin[degree[u]];
+        int w = order[first];
+
+        if (w != u) {
+            order[position[u]] = w;
+            position[w] = position[u];
+            order[first] = u;
+            position[u] = first;
+        }
+
+        bin[degree[u]]++;
+        degree[u]--;
+    };
+
+    for (int i = 0; i < numVertex; i++) {
+        int v = order[i];
+        View<int> adjacency = this->getAdjacencyView(v);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            lower(adjacency[j], v);
+
+        if (this->directed()) {
+            View<int> reverseAdjacency = this->getReverseAdjacencyView(v);
+
+            for (int j = 0; j < reverseAdjacency.size(); j++)
+                lower(reverseAdjacency[j], v);
+        }
+    }
+
+    List<int> coreList(numVertex, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        coreList[i] = degree[i];
+
+    return coreList;
+}
+
+// same core numbers by parallel peeling, level k removes every vertex left with degree at most k
+// a vertex is pushed to the next frontier of its level by the thread that takes its degree from k + 1 to k,
+// so it is pushed once and no locks are needed
+List<int> Graph::getParallelCoreNumbers() {
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = this->getNumVertex();
+    vector<atomic<int>> degree(numVertex);
+    vector<vector<int>> next(pool.size());
+    vector<int> frontier;
+    List<int> coreList(numVertex, -1);
+    int numRemoved = 0;
+
+    if (numVertex == 0)
+        return coreList;
+
+    // the views are built here, before the threads read them
+    this->getAdjacencyView(0);
+    this->getReverseAdjacencyView(0);
+
+    pool.parallelFor(0, numVertex, [&](long begin, long end, int) {
+        for (long i = begin; i < end; i++)
+            degree[i].store(this->getCoreDegree(i), memory_order_relaxed);
+    });
+
+    auto peel = [&](int u, int k, int threadId) {
+        if (coreList[u] == -1 and degree[u].fetch_sub(1, memory_order_relaxed) == k + 1)
+            next[threadId].push_back(u);
+    };
+
+    for (int k = 0; numRemoved < numVertex; k++) {
+        int minDegree = -1;
+
+        frontier.clear();
+
+        // levels below the smallest degree left are empty
+        for (int i = 0; i < numVertex; i++)
+            if (coreList[i] == -1 and (minDegree == -1 or degree[i].load(memory_order_relaxed) < minDegree))
+                minDegree = degree[i].load(memory_order_relaxed);
+
+        k = max(k, minDegree);
+
+        for (int i = 0; i < numVertex; i++)
+            if (coreList[i] == -1 and degree[i].load(memory_order_relaxed) <= k)
+                frontier.push_back(i);
+
+        while (!frontier.empty()) {
+            for (int i = 0; i < (int) frontier.size(); i++)
+                coreList[frontier[i]] = k;
+
+            numRemoved += frontier.size();
+
+            pool.parallelFor(0, frontier.size(), [&](long begin, long end, int threadId) {
+                for (long i = begin; i < end; i++) {
+                    int v = frontier[i];
+                    View<int> adjacency = this->getAdjacencyView(v);
+
+                    for (int j = 0; j < adjacency.size(); j++)
+                        peel(adjacency[j], k, threadId);
+
+                    if (this->directed()) {
+                        View<int> reverseAdjacency = this->getReverseAdjacencyView(v);
+
+                        for (int j = 0; j < reverseAdjacency.size(); j++)
+                            peel(reverseAdjacency[j], k, threadId);
+                    }
+                }
+            });
+
+            frontier.clear();
+
+            for (int t = 0; t < (int) next.size(); t++) {
+                frontier.insert(frontier.end(), next[t].begin(), next[t].end());
+                next[t].clear();
+            }
+        }
+    }
+
+    return coreList;
+}
+
+// ids of the vertex whose core number is below k
+List<int> Graph::getVertexListOutsideCore(int k) {
+    List<int> coreList = this->getCoreNumbers();
+    List<int> outsideList;
+
+    for (int i = 0; i < coreList.size(); i++)
+        if (coreList[i] < k)
+            outsideList.insert(this->storage->vertexList[i]);
+
+    return outsideList;
+}
+
+// subgraph induced by the vertex of core number at least k, where every vertex has degree k or more
+Graph Graph::getKCore(int k) {
+    Graph core(*this);
+
+    core.removeVertices(this->getVertexListOutsideCore(k));
+    return core;
+}
@@ -0,0 +1,286 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <vector>
+#include <unordered_map>
+#include <type_traits>
+#include "graph.hpp"
+#include "list.hpp"
+
+using namespace std;
+
+// weight type of graphs without weights, edges spend no storage on it
+struct NoWeight {};
+
+template <typename VertexId, typename Weight>
+struct CoreEdge {
+    VertexId source;
+    VertexId destination;
+    Weight weight;
+};
+
+template <typename VertexId>
+struct CoreEdge<VertexId, NoWeight> {
+    VertexId source;
+    VertexId destination;
+};
+
+// graph specialized at compile time on vertex id, weight and directedness
+// a standalone library type, Graph and Digraph do not build on it; fromGraph copies one of them into it
+template <typename VertexId, typename Weight, bool Directed>
+class GraphCore {
+    public:
+        typedef CoreEdge<VertexId, Weight> EdgeType;
+        static constexpr bool directed = Directed;
+        static constexpr bool weighted = !is_same<Weight, NoWeight>::value;
+
+        GraphCore() = default;
+        static GraphCore fromGraph(Graph& graph);
+        void addVertex(VertexId vertex);
+        void addEdge(VertexId source, VertexId destination, Weight weight = Weight());
+        bool hasVertex(VertexId vertex) const;
+        bool hasEdge(VertexId source, VertexId destination);
+        int getVertexIndex(VertexId vertex) const;
+        VertexId vertexAt(int index) const;
+        const EdgeType& edgeAt(long index) const;
+        int getNumVertex() const;
+        long getNumEdges() const;
+        long getVertexDegree(VertexId vertex);
+        const int* neighborsBegin(int vertexIndex);
+        const int* neighborsEnd(int vertexIndex);
+        List<VertexId> getBFSOrder(VertexId vertex);
+        bool connected();
+
+    private:
+        vector<VertexId> vertexList;
+        vector<EdgeType> edgeList;
+        unordered_map<VertexId, int> vertexIndexMap;
+        vector<long> adjacencyOffset;
+        vector<int> adjacencyTarget;
+        bool adjacencyUpdated = false;
+        void updateAdjacency();
+};
+
+// common instantiations, the ids and weights of the runtime graph with and without the weights
+typedef GraphCore<int, int, false> StaticGraph;
+typedef GraphCore<int, int, true> StaticDigraph;
+typedef GraphCore<int, NoWeight, false> StaticUnweightedGraph;
+typedef GraphCore<int, NoWeight, true> StaticUnweightedDigraph;
+
+static_assert(sizeof(CoreEdge<int, NoWeight>) == 2 * sizeof(int), "unweighted edges must not store a weight");
+
+
+// copy a runtime graph, both store an undirected edge once
+template <typename VertexId, typename Weight, bool Directed>
+GraphCore<VertexId, Weight, Directed> GraphCore<VertexId, Weight, Directed>::fromGraph(Graph& graph) {
+    GraphCore core;
+    View<int> vertexList = graph.getVertexView();
+    View<Edge> edgeList = graph.getEdgeView();
+
+    for (int i = 0; i < vertexList.size(); i++)
+        core.addVertex(vertexList[i]);
+
+    for (int i = 0; i < edgeList.size(); i++) {
+        const Edge& edge = edgeList[i];
+
+        if constexpr (GraphCore::weighted)
+            core.addEdge(edge.getSource(), edge.getDestination(), Weight(edge.hasWeight() ? edge.getWeight() : 1));
+        else
+            core.addEdge(edge.getSource(), edge.getDestination());
+    }
+
+    return core;
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+void GraphCore<VertexId, Weight, Directed>::addVertex(VertexId vertex) {
+    if (this->hasVertex(vertex))
+        return;
+
+    this->vertexIndexMap.emplace(vertex, this->vertexList.size());
+    this->vertexList.push_back(vertex);
+    this->adjacencyUpdated = false;
+}
+
+// undirected edges are stored once, the adjacency makes them symmetric
+template <typename VertexId, typename Weight, bool Directed>
+void GraphCore<VertexId, Weight, Directed>::addEdge(VertexId source, VertexId destination, Weight weight) {
+    exception e;
+
+    if (!this->hasVertex(source) or !this->hasVertex(destination))
+        throw e;
+
+    if constexpr (GraphCore::weighted)
+        this->edgeList.push_back({source, destination, weight});
+    else
+        this->edgeList.push_back({source, destination});
+
+    this->adjacencyUpdated = false;
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+bool GraphCore<VertexId, Weight, Directed>::hasVertex(VertexId vertex) const {
+    return this->vertexIndexMap.find(vertex) != this->vertexIndexMap.end();
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+bool GraphCore<VertexId, Weight, Directed>::hasEdge(VertexId source, VertexId destination) {
+    if (!this->hasVertex(source) or !this->hasVertex(destination))
+        return false;
+
+    int destinationIndex = this->getVertexIndex(destination);
+    int sourceIndex = this->getVertexIndex(source);
+
+    for (const int* it = this->neighborsBegin(sourceIndex); it != this->neighborsEnd(sourceIndex); it++)
+        if (*it == destinationIndex)
+            return true;
+
+    return false;
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+int GraphCore<VertexId, Weight, Directed>::getVertexIndex(VertexId vertex) const {
+    typename unordered_map<VertexId, int>::const_iterator it = this->vertexIndexMap.find(vertex);
+
+    if (it == this->vertexIndexMap.end())
+        return -1;
+
+    return it->second;
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+VertexId GraphCore<VertexId, Weight, Directed>::vertexAt(int index) const {
+    return this->vertexList[index];
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+const CoreEdge<VertexId, Weight>& GraphCore<VertexId, Weight, Directed>::edgeAt(long index) const {
+    return this->edgeList[index];
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+int GraphCore<VertexId, Weight, Directed>::getNumVertex() const {
+    return this->vertexList.size();
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+long GraphCore<VertexId, Weight, Directed>::getNumEdges() const {
+    return this->edgeList.size();
+}
+
+// out-degree for digraphs, degree for graphs
+template <typename VertexId, typename Weight, bool Directed>
+long GraphCore<VertexId, Weight, Directed>::getVertexDegree(VertexId vertex) {
+    int vertexIndex = this->getVertexIndex(vertex);
+
+    if (vertexIndex == -1)
+        return 0;
+
+    return this->neighborsEnd(vertexIndex) - this->neighborsBegin(vertexIndex);
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+const int* GraphCore<VertexId, Weight, Directed>::neighborsBegin(int vertexIndex) {
+    this->updateAdjacency();
+    return this->adjacencyTarget.data() + this->adjacencyOffset[vertexIndex];
+}
+
+template <typename VertexId, typename Weight, bool Directed>
+const int* GraphCore<VertexId, Weight, Directed>::neighborsEnd(int vertexIndex) {
+    this->updateAdjacency();
+    return this->adjacencyTarget.data() + this->adjacencyOffset[vertexIndex + 1];
+}
+
+// build the compact adjacency of neighbor indexes, one counting pass and one fill pass
+template <typename VertexId, typename Weight, bool Directed>
+void GraphCore<VertexId, Weight, Directed>::updateAdjacency() {
+    if (this->adjacencyUpdated)
+        return;
+
+    int numVertex = this->vertexList.size();
+    vector<long> next(numVertex + 1, 0);
+
+    this->adjacencyOffset.assign(numVertex + 1, 0);
+
+    for (long i = 0; i < (long) this->edgeList.size(); i++) {
+        this->adjacencyOffset[this->getVertexIndex(this->edgeList[i].source) + 1]++;
+
+        if constexpr (!Directed)
+            this->adjacencyOffset[this->getVertexIndex(this->edgeList[i].destination) + 1]++;
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        this->adjacencyOffset[i + 1] += this->adjacencyOffset[i];
+
+    for (int i = 0; i <= numVertex; i++)
+        next[i] = this->adjacencyOffset[i];
+
+    this->adjacencyTarget.resize(this->adjacencyOffset[numVertex]);
+
+    for (long i = 0; i < (long) this->edgeList.size(); i++) {
+        int sourceIndex = this->getVertexIndex(this->edgeList[i].source);
+        int destinationIndex = this->getVertexIndex(this->edgeList[i].destination);
+
+        this->adjacencyTarget[next[sourceIndex]++] = destinationIndex;
+
+        if constexpr (!Directed)
+            this->adjacencyTarget[next[destinationIndex]++] = sourceIndex;
+    }
+
+    this->adjacencyUpdated = true;
+}
+
+// breadth first order of the vertex reachable from the given one
+template <typename VertexId, typename Weight, bool Directed>
+List<VertexId> GraphCore<VertexId, Weight, Directed>::getBFSOrder(VertexId vertex) {
+    int numVertex = this->getNumVertex();
+    vector<char> visited(numVertex, 0);
+    vector<int> queue;
+
+    if (!this->hasVertex(vertex))
+        return List<VertexId>();
+
+    queue.push_back(this->getVertexIndex(vertex));
+    visited[queue[0]] = 1;
+
+    for (int head = 0; head < (int) queue.size(); head++) {
+        for (const int* it = this->neighborsBegin(queue[head]); it != this->neighborsEnd(queue[head]); it++) {
+            if (!visited[*it]) {
+                visited[*it] = 1;
+                queue.push_back(*it);
+            }
+        }
+    }
+
+    List<VertexId> order(queue.size(), VertexId());
+
+    for (int i = 0; i < (int) queue.size(); i++)
+        order[i] = this->vertexList[queue[i]];
+
+    return order;
+}
+
+// weak connectivity for digraphs, the edges are followed both ways
+template <typename VertexId, typename Weight, bool Directed>
+bool GraphCore<VertexId, Weight, Directed>::connected() {
+    if (this->getNumVertex() == 0)
+        return true;
+
+    if constexpr (Directed) {
+        GraphCore<VertexId, Weight, false> undirected;
+
+        for (int i = 0; i < this->getNumVertex(); i++)
+            undirected.addVertex(this->vertexList[i]);
+
+        for (long i = 0; i < this->getNumEdges(); i++) {
+            if constexpr (GraphCore::weighted)
+                undirected.addEdge(this->edgeList[i].source, this->edgeList[i].destination, this->edgeList[i].weight);
+            else
+                undirected.addEdge(this->edgeList[i].source, this->edgeList[i].destination);
+        }
+
+        return undirected.connected();
+    } else {
+        return this->getBFSOrder(this->vertexList[0]).size() == this->getNumVertex();
+    }
+}
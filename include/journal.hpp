@@ -0,0 +1,283 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include "graph.hpp"
+#include "digraph.hpp"
+#include "resources.hpp"
+#include "list.hpp"
+
+using namespace std;
+
+// append-only log of the mutations made since the last snapshot of a graph file, kept in <file>.journal
+// the first line holds a hash of the snapshot it applies to, so a stale journal is never replayed
+//
+//   journal <snapshot hash>
+//   +v <vertex>                    -v <vertex>
+//   +e <source> <destination> [w]  -e <source> <destination> [w]
+//   t
+class Journal : public GraphObserver {
+    public:
+        Journal(string snapshotPath, int minEntries = 1024);
+        Journal(const Journal& other) = delete;
+        Journal& operator=(const Journal& other) = delete;
+        ~Journal();
+        int replay(Graph& graph);
+        void onAddVertex(int vertex);
+        void onRemoveVertices(View<int> vertexList);
+        void onAddEdges(View<Edge> edgeList);
+        void onRemoveEdges(View<Edge> edgeList);
+        void onTranspose();
+        bool compactionDue(Graph& graph) const;
+        void compact(Graph& graph);
+        int size() const;
+        string path() const;
+
+    private:
+        string snapshotPath;
+        string journalPath;
+        ofstream output;
+        int numEntries = 0;
+        int minEntries;
+        void restart(string snapshotFilePath);
+        void writeEdges(string operation, View<Edge> edgeList);
+        static unsigned long long fileHash(string filePath);
+};
+
+
+// constructor, nothing is touched until the journal is replayed
+Journal::Journal(string snapshotPath, int minEntries) {
+    this->snapshotPath = snapshotPath;
+    this->journalPath = snapshotPath + ".journal";
+    this->minEntries = minEntries;
+}
+
+Journal::~Journal() {
+    if (this->output.is_open())
+        this->output.close();
+}
+
+// apply the journal of the snapshot to a graph freshly loaded from it, then keep appending to it
+// consecutive edge and vertex removals are applied as one batch, return the number of entries applied
+int Journal::replay(Graph& graph) {
+    ifstream input(this->journalPath);
+    string line, operation, header;
+    unsigned long long hash = 0;
+    List<Edge> pendingEdges;
+    List<int> pendingVertices;
+    string pendingOperation;
+    bool torn = false;
+
+    auto flush = [&]() {
+        if (pendingOperation == "+e")
+            graph.addEdges(pendingEdges);
+        else if (pendingOperation == "-e")
+            graph.removeEdges(pendingEdges);
+        else if (pendingOperation == "-v")
+            graph.removeVertices(pendingVertices);
+
+        pendingEdges.clear();
+        pendingVertices.clear();
+        pendingOperation = "";
+    };
+
+    this->numEntries = 0;
+
+    // a missing or stale journal starts over from the current snapshot
+    if (!input.is_open() or !getline(input, line) or !(stringstream(line) >> header >> hash) or
+        header != "journal" or hash != Journal::fileHash(this->snapshotPath)) {
+        this->restart(this->snapshotPath);
+        return 0;
+    }
+
+    while (getline(input, line)) {
+        stringstream buffer(line);
+        int source, destination, weight;
+
+        // a torn last line, left by an interrupted write, ends the replay
+        if (input.eof() or !(buffer >> operation)) {
+            torn = true;
+            break;
+        }
+
+        if (operation != pendingOperation)
+            flush();
+
+        if (operation == "+e" or operation == "-e") {
+            if (!(buffer >> source >> destination)) {
+                torn = true;
+                break;
+            }
+
+            Edge edge(source, destination);
+
+            if (buffer >> weight)
+                edge.setWeight(weight);
+
+            pendingEdges.insert(edge);
+        } else if (operation == "-v") {
+            if (!(buffer >> source)) {
+                torn = true;
+                break;
+            }
+
+            pendingVertices.insert(source);
+        } else if (operation == "+v") {
+            if (!(buffer >> source)) {
+                torn = true;
+                break;
+            }
+
+            graph.addVertex(source);
+            this->numEntries++;
+            continue;
+        } else if (operation == "t") {
+            Digraph* digraph = dynamic_cast<Digraph*>(&graph);
+
+            if (digraph != nullptr)
+                digraph->transpose();
+
+            this->numEntries++;
+            continue;
+        } else {
+            torn = true;
+            break;
+        }
+
+        pendingOperation = operation;
+        this->numEntries++;
+    }
+
+    flush();
+    input.close();
+
+    // appending after a partial line would glue the next entry to it, so the
+    // entries that were applied go into a new snapshot and the journal starts over
+    if (torn) {
+        int numApplied = this->numEntries;
+
+        cout << "discarding a torn entry at the end of " << this->journalPath << endl;
+        this->compact(graph);
+        return numApplied;
+    }
+
+    this->output.open(this->journalPath, ios::app);
+
+    if (!this->output.is_open())
+        throw runtime_error("failed to open the journal file");
+
+    return this->numEntries;
+}
+
+void Journal::onAddVertex(int vertex) {
+    this->output << "+v " << vertex << "\n";
+    this->output.flush();
+    this->numEntries++;
+}
+
+void Journal::onRemoveVertices(View<int> vertexList) {
+    for (int i = 0; i < vertexList.size(); i++)
+        this->output << "-v " << vertexList[i] << "\n";
+
+    this->output.flush();
+    this->numEntries += vertexList.size();
+}
+
+void Journal::onAddEdges(View<Edge> edgeList) {
+    this->writeEdges("+e", edgeList);
+}
+
+void Journal::onRemoveEdges(View<Edge> edgeList) {
+    this->writeEdges("-e", edgeList);
+}
+
+void Journal::onTranspose() {
+    this->output << "t\n";
+    this->output.flush();
+    this->numEntries++;
+}
+
+// a snapshot costs about the size of the graph, so it is due once the journal is comparable to it
+bool Journal::compactionDue(Graph& graph) const {
+    long graphSize = (long) graph.getNumVertex() + graph.getNumEdges();
+
+    return this->numEntries >= this->minEntries and 4L * this->numEntries >= graphSize;
+}
+
+// write a full snapshot and start an empty journal for it
+// the snapshot is renamed before the journal, a crash in between leaves a stale journal that is ignored
+void Journal::compact(Graph& graph) {
+    string snapshotTemporaryPath = this->snapshotPath + ".tmp";
+
+    generateGraphText(graph, snapshotTemporaryPath);
+
+// windows does not rename over an existing file
+#ifdef _WIN32
+    remove(this->snapshotPath.c_str());
+#endif
+
+    if (rename(snapshotTemporaryPath.c_str(), this->snapshotPath.c_str()) != 0)
+        throw runtime_error("failed to replace the graph file");
+
+    this->restart(this->snapshotPath);
+}
+
+// return the number of entries since the last snapshot
+int Journal::size() const {
+    return this->numEntries;
+}
+
+string Journal::path() const {
+    return this->journalPath;
+}
+
+// truncate the journal and bind it to the given snapshot
+void Journal::restart(string snapshotFilePath) {
+    if (this->output.is_open())
+        this->output.close();
+
+    this->output.open(this->journalPath, ios::trunc);
+
+    if (!this->output.is_open())
+        throw runtime_error("failed to open the journal file");
+
+    this->output << "journal " << Journal::fileHash(snapshotFilePath) << "\n";
+    this->output.flush();
+    this->numEntries = 0;
+}
+
+void Journal::writeEdges(string operation, View<Edge> edgeList) {
+    for (int i = 0; i < edgeList.size(); i++) {
+        this->output << operation << " " << edgeList[i].getSource() << " " << edgeList[i].getDestination();
+
+        if (edgeList[i].hasWeight())
+            this->output << " " << edgeList[i].getWeight();
+
+        this->output << "\n";
+    }
+
+    this->output.flush();
+    this->numEntries += edgeList.size();
+}
+
+// fnv-1a over the file bytes, zero for a missing file
+unsigned long long Journal::fileHash(string filePath) {
+    ifstream input(filePath, ios::binary);
+    unsigned long long hash = 14695981039346656037ULL;
+    char block[1 << 16];
+
+    if (!input.is_open())
+        return 0;
+
+    while (input.read(block, sizeof(block)) or input.gcount() > 0) {
+        for (streamsize i = 0; i < input.gcount(); i++) {
+            hash ^= (unsigned char) block[i];
+            hash *= 1099511628211ULL;
+        }
+    }
+
+    return hash;
+}
@@ -1,5 +1,6 @@
 #pragma once
 #include <iostream> 
+#include <utility>
 
 using namespace std; 
 
@@ -9,19 +10,24 @@ class List {
         List() = default; 
         List(int size, T value); 
         List(const List<T>& other); 
+        List(List<T>&& other); 
         bool operator==(const List<T>& other) const; 
         bool operator!=(const List<T>& other) const; 
         List<T>& operator=(const List<T>& other); 
+        List<T>& operator=(List<T>&& other); 
         T& operator[](const int index) const;
         template <typename U> friend ostream& operator<<(ostream& os, const List<U>& list);
         ~List(); 
         void insert(T element);
+        void reserve(int capacity);
         void insertAt(int index, T element);
         void remove(T element);
+        template <typename Predicate> void removeIf(Predicate predicate);
         T removeFirst();
         bool has(T element) const;
         int indexOf(T element) const;
         T& at(int index) const;
+        T* data() const;
         int size() const;
         void printList() const;
         bool empty();
@@ -32,6 +38,7 @@ class List {
     private:
         T* list = nullptr;
         int numElements = 0;
+        int capacity = 0;
         void deleteList();
 };
 
@@ -40,6 +47,7 @@ template <typename T>
 List<T>::List(const List<T>& other) {
     if (this != &other) {
         this->numElements = other.size();
+        this->capacity = other.size();
         this->list = new T[other.size()];
 
         for (int i = 0; i < other.size(); i++) {
@@ -48,9 +56,21 @@ List<T>::List(const List<T>& other) {
     }
 }
 
+// move constructor, takes the other buffer
+template <typename T>
+List<T>::List(List<T>&& other) {
+    this->list = other.list;
+    this->numElements = other.numElements;
+    this->capacity = other.capacity;
+    other.list = nullptr;
+    other.numElements = 0;
+    other.capacity = 0;
+}
+
 template <typename T>
 List<T>::List(int size, T value) {
     numElements = size;
+    capacity = size;
     list = new T[numElements];
 
     for (int i = 0; i < numElements; i++)
@@ -63,18 +83,29 @@ List<T>::~List() {
     this->deleteList();
 }
 
+// the buffer grows geometrically, so a run of inserts is linear
 template <typename T>
 void List<T>::insert(T element) {
-    T *newList = new T[this->numElements+1];
+    if (this->numElements == this->capacity)
+        this->reserve(this->capacity < 4 ? 8 : 2 * this->capacity);
+
+    this->list[this->numElements++] = element;
+}
+
+template <typename T>
+void List<T>::reserve(int capacity) {
+    if (capacity <= this->capacity)
+        return;
+
+    T *newList = new T[capacity];
 
     for (int i = 0; i < this->numElements; i++) {
-        newList[i] = this->list[i];
+        newList[i] = move(this->list[i]);
     }
-    newList[this->numElements] = element;
 
     delete[] this->list;
     this->list = newList;
-    this->numElements++;
+    this->capacity = capacity;
 }
 
 template <typename T>
@@ -84,24 +115,32 @@ void List<T>::insertAt(int index, T element) {
 
 template <typename T>
 void List<T>::remove(T element) {
-    if (!this->has(element)) return;
+    int i = this->indexOf(element);
 
-    T *newList = new T[this->numElements-1];
+    if (i == -1) return;
 
-    int i = 0;
-    int count = 0;
+    for (int j = i + 1; j < this->numElements; j++) {
+        this->list[j - 1] = move(this->list[j]);
+    }
 
-    while (this->list[i] != element) 
-        i++;
+    this->numElements--;
+}
+
+// drop every element matching the predicate in one pass, keeping the order of the rest
+template <typename T>
+template <typename Predicate>
+void List<T>::removeIf(Predicate predicate) {
+    int count = 0;
 
-    for (int j = 0; j < this->numElements; j++) {
-        if (j != i)
-            newList[count++] = this->list[j];
+    for (int i = 0; i < this->numElements; i++) {
+        if (!predicate(this->list[i])) {
+            if (count != i)
+                this->list[count] = move(this->list[i]);
+            count++;
+        }
     }
 
-    delete[] this->list;
-    this->list = newList;
-    this->numElements--;
+    this->numElements = count;
 }
 
 template <typename T>
@@ -134,9 +173,16 @@ T& List<T>::at(int index) const {
     return this->list[index];
 }
 
+// return the underlying buffer
+template <typename T>
+T* List<T>::data() const {
+    return this->list;
+}
+
 template <typename T>
 void List<T>::deleteList() {
     this->numElements = 0;
+    this->capacity = 0;
     
     if (this->list != nullptr) {
         delete[] this->list;
@@ -176,7 +222,9 @@ bool List<T>::operator!=(const List<T>& other) const {
 template <typename T>
 List<T>& List<T>::operator=(const List<T>& other) {
     if (this != &other) {
+        this->deleteList();
         this->numElements = other.size();
+        this->capacity = other.size();
         this->list = new T[other.size()];
 
         for (int i = 0; i < other.size(); i++) {
@@ -187,6 +235,21 @@ List<T>& List<T>::operator=(const List<T>& other) {
     return *this;
 }
 
+template <typename T>
+List<T>& List<T>::operator=(List<T>&& other) {
+    if (this != &other) {
+        this->deleteList();
+        this->list = other.list;
+        this->numElements = other.numElements;
+        this->capacity = other.capacity;
+        other.list = nullptr;
+        other.numElements = 0;
+        other.capacity = 0;
+    }
+
+    return *this;
+}
+
 template <typename T>
 ostream& operator<<(ostream& os, const List<T>& list) {
     for (int i = 0; i < list.size(); i++) {
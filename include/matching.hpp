@@ -0,0 +1,232 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <vector>
+#include "graph.hpp"
+#include "list.hpp"
+
+using namespace std;
+
+// 2-coloring of a graph by vertex index, or an odd cycle proving there is none
+// the cycle holds vertex ids in order, its last vertex is adjacent to the first
+struct Bipartition {
+    bool bipartite = true;
+    List<int> side;
+    List<int> oddCycle;
+};
+
+// mate of every vertex by index, -1 when unmatched
+struct Matching {
+    List<int> mate;
+    int size = 0;
+};
+
+Bipartition getBipartition(Graph& graph);
+Matching getMaximumMatching(Graph& graph, bool greedyStart = true);
+
+
+// bfs 2-coloring in O(V + E), edge directions are ignored
+// an edge between two vertex of the same color closes an odd cycle through their bfs tree paths
+Bipartition getBipartition(Graph& graph) {
+    int numVertex = graph.getNumVertex();
+    vector<int> parent(numVertex, -1), depth(numVertex, -1), queue;
+    Bipartition result;
+
+    result.side = List<int>(numVertex, -1);
+    queue.reserve(numVertex);
+
+    for (int root = 0; root < numVertex; root++) {
+        if (depth[root] != -1)
+            continue;
+
+        queue.clear();
+        queue.push_back(root);
+        depth[root] = 0;
+
+        for (int head = 0; head < (int) queue.size(); head++) {
+            int v = queue[head];
+
+            for (int direction = 0; direction < (graph.directed() ? 2 : 1); direction++) {
+                View<int> adjacency = direction == 0 ? graph.getAdjacencyView(v) : graph.getReverseAdjacencyView(v);
+
+                for (int j = 0; j < adjacency.size(); j++) {
+                    int w = adjacency[j];
+
+                    if (depth[w] == -1) {
+                        depth[w] = depth[v] + 1;
+                        parent[w] = v;
+                        queue.push_back(w);
+                        continue;
+                    }
+
+                    if ((depth[w] - depth[v]) % 2 != 0)
+                        continue;
+
+                    // climb both tree paths to the common ancestor, same depth so they meet together
+                    List<int> fromV, fromW;
+                    int a = v, b = w;
+
+                    while (a != b) {
+                        fromV.insert(graph.vertexAt(a));
+                        fromW.insert(graph.vertexAt(b));
+                        a = parent[a];
+                        b = parent[b];
+                    }
+
+                    result.bipartite = false;
+                    result.side = List<int>();
+                    result.oddCycle.reserve(fromV.size() + fromW.size() + 1);
+                    result.oddCycle.insert(graph.vertexAt(a));
+
+                    for (int i = fromW.size() - 1; i >= 0; i--)
+                        result.oddCycle.insert(fromW[i]);
+
+                    for (int i = 0; i < fromV.size(); i++)
+                        result.oddCycle.insert(fromV[i]);
+
+                    return result;
+                }
+            }
+        }
+    }
+
+    for (int i = 0; i < numVertex; i++)
+        result.side[i] = depth[i] % 2;
+
+    return result;
+}
+
+// hopcroft-karp maximum cardinality matching, O(E sqrt(V)), the graph must be bipartite
+// every phase layers the free left vertex by bfs and augments a maximal set of disjoint shortest paths,
+// each found by a dfs on an explicit stack so deep layers do not grow the call stack
+Matching getMaximumMatching(Graph& graph, bool greedyStart) {
+    int numVertex = graph.getNumVertex();
+    Bipartition bipartition = getBipartition(graph);
+    Matching matching;
+    exception e;
+
+    if (!bipartition.bipartite)
+        throw e;
+
+    // neighbors of the left vertex (side 0) in one contiguous array
+    vector<int> offset(numVertex + 1, 0), neighbors, leftList;
+
+    for (int v = 0; v < numVertex; v++) {
+        if (bipartition.side[v] == 0) {
+            leftList.push_back(v);
+
+            for (int direction = 0; direction < (graph.directed() ? 2 : 1); direction++) {
+                View<int> adjacency = direction == 0 ? graph.getAdjacencyView(v) : graph.getReverseAdjacencyView(v);
+                neighbors.insert(neighbors.end(), adjacency.begin(), adjacency.end());
+            }
+        }
+
+        offset[v + 1] = neighbors.size();
+    }
+
+    const int unreached = -1;
+    vector<int> mate(numVertex, -1), layer(numVertex), next(numVertex), queue, stack;
+
+    queue.reserve(leftList.size());
+    stack.reserve(leftList.size());
+
+    // a free neighbor for every left vertex that has one, most of the matching before the first phase
+    if (greedyStart)
+        for (int u : leftList)
+            for (int j = offset[u]; j < offset[u + 1] and mate[u] == -1; j++)
+                if (mate[neighbors[j]] == -1) {
+                    mate[u] = neighbors[j];
+                    mate[neighbors[j]] = u;
+                    matching.size++;
+                }
+
+    while (true) {
+        // layer of the left vertex next to the nearest free right vertex, the length of the shortest augmenting paths
+        int limit = numVertex;
+
+        queue.clear();
+
+        for (int u : leftList) {
+            layer[u] = mate[u] == -1 ? 0 : unreached;
+
+            if (mate[u] == -1)
+                queue.push_back(u);
+        }
+
+        // layers alternate free edges out of the left and matched edges back to it,
+        // nothing past the layer of the first free right vertex is on a shortest path
+        for (int head = 0; head < (int) queue.size(); head++) {
+            int u = queue[head];
+
+            if (layer[u] > limit)
+                break;
+
+            for (int j = offset[u]; j < offset[u + 1]; j++) {
+                int m = mate[neighbors[j]];
+
+                if (m == -1) {
+                    limit = min(limit, layer[u]);
+                } else if (layer[m] == unreached and layer[u] < limit) {
+                    layer[m] = layer[u] + 1;
+                    queue.push_back(m);
+                }
+            }
+        }
+
+        if (limit == numVertex)
+            break;
+
+        for (int u : leftList)
+            next[u] = offset[u];
+
+        // the stack is the path, every vertex on it was reached through its neighbor at next - 1
+        for (int root : leftList) {
+            if (mate[root] != -1)
+                continue;
+
+            stack.clear();
+            stack.push_back(root);
+
+            while (!stack.empty()) {
+                int u = stack.back();
+
+                // dead end, no shortest augmenting path goes through u in this phase
+                if (next[u] == offset[u + 1]) {
+                    layer[u] = unreached;
+                    stack.pop_back();
+                    continue;
+                }
+
+                int w = neighbors[next[u]++];
+                int m = mate[w];
+
+                if (m != -1 and layer[m] == layer[u] + 1 and layer[m] <= limit) {
+                    stack.push_back(m);
+                    continue;
+                }
+
+                // a free vertex ends a shortest path only from the last layer
+                if (m != -1 or layer[u] != limit)
+                    continue;
+
+                for (int i = 0; i < (int) stack.size(); i++) {
+                    int x = stack[i];
+                    int y = neighbors[next[x] - 1];
+
+                    mate[x] = y;
+                    mate[y] = x;
+                }
+
+                matching.size++;
+                break;
+            }
+        }
+    }
+
+    matching.mate = List<int>(numVertex, -1);
+
+    for (int i = 0; i < numVertex; i++)
+        matching.mate[i] = mate[i];
+
+    return matching;
+}
@@ -0,0 +1,432 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "graph.hpp"
+#include "list.hpp"
+
+using namespace std;
+
+// maximum flow between two vertex and a minimum cut separating them
+//   flowList      edges carrying flow, weighted by it, in the direction it goes
+//   sourceSide    ids of the vertex still reachable from the source in the residual graph
+//   cutEdgeList   edges from the source side to the rest, their capacities add up to the flow value
+struct MaximumFlow {
+    long value = 0;
+    List<Edge> flowList;
+    List<int> sourceSide;
+    List<Edge> cutEdgeList;
+};
+
+// highest label push-relabel on a residual graph held in contiguous arrays
+// the arcs leaving a vertex are contiguous, and arc a and reverse[a] are the two directions of the same edge
+// edge weights are the capacities (1 when missing), an undirected edge has its capacity both ways
+class PushRelabel {
+    public:
+        PushRelabel(Graph& graph);
+        MaximumFlow getMaximumFlow(int source, int sink);
+
+    private:
+        Graph& graph;
+        int numVertex;
+        int sourceIndex;
+        int sinkIndex;
+        vector<int> offset;
+        vector<int> head;
+        vector<int> reverse;
+        vector<long> capacity;
+        vector<long> residual;
+        vector<int> edgeArc;
+        vector<int> label;
+        vector<long> excess;
+        vector<int> current;
+        vector<int> activeHead;
+        vector<int> activeNext;
+        vector<int> layerHead;
+        vector<int> layerNext;
+        vector<int> layerPrev;
+        int maxActive;
+        int maxLabel;
+        long work;
+        void push(int v, int arc);
+        void activate(int v);
+        void addToLayer(int v);
+        void removeFromLayer(int v);
+        void globalRelabel();
+        void gap(int emptyLabel);
+        void discharge(int v);
+        void returnExcess();
+};
+
+MaximumFlow getMaximumFlow(Graph& graph, int source, int sink);
+
+
+// constructor, builds the residual graph, self loops can not carry flow and are left out
+PushRelabel::PushRelabel(Graph& graph) : graph(graph) {
+    View<Edge> edges = graph.getEdgeView();
+    vector<int> next;
+
+    this->numVertex = graph.getNumVertex();
+    this->offset.assign(this->numVertex + 1, 0);
+    this->edgeArc.assign(edges.size(), -1);
+
+    for (int i = 0; i < edges.size(); i++) {
+        int u = graph.getVertexIndex(edges[i].getSource());
+        int v = graph.getVertexIndex(edges[i].getDestination());
+
+        if (edges[i].hasWeight() and edges[i].getWeight() < 0)
+            throw runtime_error("edge capacities must not be negative");
+
+        if (u != v) {
+            this->offset[u + 1]++;
+            this->offset[v + 1]++;
+        }
+    }
+
+    for (int i = 0; i < this->numVertex; i++)
+        this->offset[i + 1] += this->offset[i];
+
+    int numArcs = this->offset[this->numVertex];
+    next.assign(this->offset.begin(), this->offset.end() - 1);
+    this->head.resize(numArcs);
+    this->reverse.resize(numArcs);
+    this->capacity.resize(numArcs);
+
+    for (int i = 0; i < edges.size(); i++) {
+        int u = graph.getVertexIndex(edges[i].getSource());
+        int v = graph.getVertexIndex(edges[i].getDestination());
+        long edgeCapacity = edges[i].hasWeight() ? edges[i].getWeight() : 1;
+
+        if (u == v)
+            continue;
+
+        int forward = next[u]++, backward = next[v]++;
+
+        this->head[forward] = v;
+        this->head[backward] = u;
+        this->reverse[forward] = backward;
+        this->reverse[backward] = forward;
+        this->capacity[forward] = edgeCapacity;
+        this->capacity[backward] = graph.directed() ? 0 : edgeCapacity;
+        this->edgeArc[i] = forward;
+    }
+}
+
+// source and sink are vertex ids
+MaximumFlow PushRelabel::getMaximumFlow(int source, int sink) {
+    MaximumFlow result;
+
+    this->sourceIndex = this->graph.getVertexIndex(source);
+    this->sinkIndex = this->graph.getVertexIndex(sink);
+
+    if (this->sourceIndex == -1 or this->sinkIndex == -1 or this->sourceIndex == this->sinkIndex)
+        throw runtime_error("the source and the sink must be two vertices of the graph");
+
+    int n = this->numVertex;
+
+    this->residual = this->capacity;
+    this->label.assign(n, 0);
+    this->excess.assign(n, 0);
+    this->current.assign(this->offset.begin(), this->offset.end() - 1);
+    this->activeHead.assign(n, -1);
+    this->activeNext.assign(n, -1);
+    this->layerHead.assign(n, -1);
+    this->layerNext.assign(n, -1);
+    this->layerPrev.assign(n, -1);
+    this->maxActive = -1;
+    this->maxLabel = 0;
+
+    // saturate every arc leaving the source
+    for (int a = this->offset[this->sourceIndex]; a < this->offset[this->sourceIndex + 1]; a++) {
+        this->excess[this->sourceIndex] += this->residual[a];
+        this->push(this->sourceIndex, a);
+    }
+
+    this->globalRelabel();
+
+    // phase one, the highest active vertex is discharged until none below n is left
+    while (this->maxActive >= 0) {
+        int v = this->activeHead[this->maxActive];
+
+        if (v == -1) {
+            this->maxActive--;
+            continue;
+        }
+
+        this->activeHead[this->maxActive] = this->activeNext[v];
+
+        // a gap moved it out of reach of the sink after it was queued
+        if (this->label[v] >= n)
+            continue;
+
+        this->discharge(v);
+
+        // relabels since the last exact labeling have made the labels loose
+        if (this->work > 6L * n + (long) this->head.size() / 2)
+            this->globalRelabel();
+    }
+
+    result.value = this->excess[this->sinkIndex];
+
+    // the excess stuck on the vertex cut off from the sink goes back to the source, so the arcs hold a flow
+    this->returnExcess();
+
+    // source side of the cut, a bfs from the source over arcs with residual capacity
+    vector<char> reached(n, 0);
+    vector<int> queue(1, this->sourceIndex);
+
+    reached[this->sourceIndex] = 1;
+
+    for (int i = 0; i < (int) queue.size(); i++)
+        for (int a = this->offset[queue[i]]; a < this->offset[queue[i] + 1]; a++)
+            if (this->residual[a] > 0 and !reached[this->head[a]]) {
+                reached[this->head[a]] = 1;
+                queue.push_back(this->head[a]);
+            }
+
+    for (int i = 0; i < n; i++)
+        if (reached[i])
+            result.sourceSide.insert(this->graph.vertexAt(i));
+
+    View<Edge> edges = this->graph.getEdgeView();
+
+    for (int i = 0; i < edges.size(); i++) {
+        int a = this->edgeArc[i];
+
+        if (a == -1)
+            continue;
+
+        int u = this->head[this->reverse[a]], v = this->head[a];
+        long flow = this->capacity[a] - this->residual[a];
+
+        if (flow > 0)
+            result.flowList.insert(Edge(edges[i].getSource(), edges[i].getDestination(), flow));
+        else if (flow < 0)
+            result.flowList.insert(Edge(edges[i].getDestination(), edges[i].getSource(), -flow));
+
+        if (reached[u] != reached[v] and (reached[u] or !this->graph.directed()))
+            result.cutEdgeList.insert(edges[i]);
+    }
+
+    return result;
+}
+
+// move as much excess as the arc takes
+void PushRelabel::push(int v, int arc) {
+    int w = this->head[arc];
+    long delta = min(this->excess[v], this->residual[arc]);
+
+    if (delta == 0)
+        return;
+
+    this->residual[arc] -= delta;
+    this->residual[this->reverse[arc]] += delta;
+    this->excess[v] -= delta;
+
+    if (this->excess[w] == 0)
+        this->activate(w);
+
+    this->excess[w] += delta;
+}
+
+// queue a vertex that just got excess, the source, the sink and the vertex cut off from the sink are never active
+void PushRelabel::activate(int v) {
+    if (v == this->sourceIndex or v == this->sinkIndex or this->label[v] >= this->numVertex)
+        return;
+
+    this->activeNext[v] = this->activeHead[this->label[v]];
+    this->activeHead[this->label[v]] = v;
+    this->maxActive = max(this->maxActive, this->label[v]);
+}
+
+// every vertex with a label below n is in the layer of its label, an empty layer is a gap
+void PushRelabel::addToLayer(int v) {
+    int l = this->label[v];
+
+    this->layerPrev[v] = -1;
+    this->layerNext[v] = this->layerHead[l];
+
+    if (this->layerHead[l] != -1)
+        this->layerPrev[this->layerHead[l]] = v;
+
+    this->layerHead[l] = v;
+    this->maxLabel = max(this->maxLabel, l);
+}
+
+void PushRelabel::removeFromLayer(int v) {
+    if (this->layerPrev[v] != -1)
+        this->layerNext[this->layerPrev[v]] = this->layerNext[v];
+    else
+        this->layerHead[this->label[v]] = this->layerNext[v];
+
+    if (this->layerNext[v] != -1)
+        this->layerPrev[this->layerNext[v]] = this->layerPrev[v];
+}
+
+// exact labels, the residual distance to the sink from a bfs backwards from it, n for the vertex that can not reach it
+void PushRelabel::globalRelabel() {
+    int n = this->numVertex;
+    vector<int> queue(1, this->sinkIndex);
+
+    fill(this->label.begin(), this->label.end(), n);
+    fill(this->activeHead.begin(), this->activeHead.end(), -1);
+    fill(this->layerHead.begin(), this->layerHead.end(), -1);
+    this->label[this->sinkIndex] = 0;
+    this->maxActive = -1;
+    this->maxLabel = 0;
+    this->work = 0;
+
+    for (int i = 0; i < (int) queue.size(); i++) {
+        int v = queue[i];
+
+        this->addToLayer(v);
+
+        if (this->excess[v] > 0)
+            this->activate(v);
+
+        for (int a = this->offset[v]; a < this->offset[v + 1]; a++) {
+            int w = this->head[a];
+
+            if (this->label[w] == n and w != this->sourceIndex and this->residual[this->reverse[a]] > 0) {
+                this->label[w] = this->label[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    for (int v = 0; v < n; v++)
+        this->current[v] = this->offset[v];
+}
+
+// nothing above an empty layer can reach the sink any more, all of it leaves phase one at once
+void PushRelabel::gap(int emptyLabel) {
+    for (int l = emptyLabel + 1; l <= this->maxLabel; l++) {
+        for (int v = this->layerHead[l]; v != -1; v = this->layerNext[v])
+            this->label[v] = this->numVertex;
+
+        this->layerHead[l] = -1;
+    }
+
+    this->maxLabel = emptyLabel - 1;
+}
+
+// push the excess of v down admissible arcs, relabel when its current arc runs out
+void PushRelabel::discharge(int v) {
+    int n = this->numVertex;
+
+    while (this->excess[v] > 0) {
+        if (this->current[v] == this->offset[v + 1]) {
+            int oldLabel = this->label[v];
+            int newLabel = n;
+
+            this->removeFromLayer(v);
+            this->work += this->offset[v + 1] - this->offset[v] + 12;
+
+            if (this->layerHead[oldLabel] == -1) {
+                this->label[v] = n;
+                this->gap(oldLabel);
+                return;
+            }
+
+            for (int a = this->offset[v]; a < this->offset[v + 1]; a++)
+                if (this->residual[a] > 0)
+                    newLabel = min(newLabel, this->label[this->head[a]] + 1);
+
+            this->label[v] = newLabel;
+            this->current[v] = this->offset[v];
+
+            if (newLabel >= n)
+                return;
+
+            this->addToLayer(v);
+            continue;
+        }
+
+        int a = this->current[v];
+
+        if (this->residual[a] > 0 and this->label[v] == this->label[this->head[a]] + 1)
+            this->push(v, a);
+
+        if (this->excess[v] > 0)
+            this->current[v]++;
+    }
+}
+
+// phase two, fifo push-relabel toward the source with labels starting at the residual distance to it
+// every unit of excess came from the source along residual arcs, so it has a way back
+void PushRelabel::returnExcess() {
+    int n = this->numVertex;
+    vector<int> queue(1, this->sourceIndex), fifo;
+    vector<char> queued(n, 0);
+
+    fill(this->label.begin(), this->label.end(), 2 * n);
+    this->label[this->sourceIndex] = 0;
+
+    for (int i = 0; i < (int) queue.size(); i++) {
+        int v = queue[i];
+
+        for (int a = this->offset[v]; a < this->offset[v + 1]; a++) {
+            int w = this->head[a];
+
+            if (this->label[w] == 2 * n and w != this->sinkIndex and this->residual[this->reverse[a]] > 0) {
+                this->label[w] = this->label[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    for (int v = 0; v < n; v++) {
+        this->current[v] = this->offset[v];
+
+        if (v != this->sourceIndex and v != this->sinkIndex and this->excess[v] > 0) {
+            fifo.push_back(v);
+            queued[v] = 1;
+        }
+    }
+
+    for (int i = 0; i < (int) fifo.size(); i++) {
+        int v = fifo[i];
+
+        queued[v] = 0;
+
+        while (this->excess[v] > 0) {
+            if (this->current[v] == this->offset[v + 1]) {
+                int newLabel = 2 * n;
+
+                for (int a = this->offset[v]; a < this->offset[v + 1]; a++)
+                    if (this->residual[a] > 0 and this->head[a] != this->sinkIndex)
+                        newLabel = min(newLabel, this->label[this->head[a]] + 1);
+
+                this->label[v] = newLabel;
+                this->current[v] = this->offset[v];
+                continue;
+            }
+
+            int a = this->current[v];
+            int w = this->head[a];
+
+            if (this->residual[a] > 0 and w != this->sinkIndex and this->label[v] == this->label[w] + 1) {
+                long delta = min(this->excess[v], this->residual[a]);
+
+                this->residual[a] -= delta;
+                this->residual[this->reverse[a]] += delta;
+                this->excess[v] -= delta;
+                this->excess[w] += delta;
+
+                if (w != this->sourceIndex and !queued[w]) {
+                    fifo.push_back(w);
+                    queued[w] = 1;
+                }
+            }
+
+            if (this->excess[v] > 0)
+                this->current[v]++;
+        }
+    }
+}
+
+// maximum flow from source to sink, vertex ids
+MaximumFlow getMaximumFlow(Graph& graph, int source, int sink) {
+    PushRelabel pushRelabel(graph);
+    return pushRelabel.getMaximumFlow(source, sink);
+}
@@ -0,0 +1,168 @@
+#pragma once
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cmath>
+#include "graph.hpp"
+#include "list.hpp"
+#include "threadpool.hpp"
+
+using namespace std;
+
+// vertices per chunk of a pagerank iteration
+#define PAGERANK_CHUNK 4096
+
+// restartVertices empty restarts uniformly on every vertex (plain pagerank), otherwise on the given vertex ids,
+// weighted by restartWeights or uniformly if it is empty (personalized pagerank)
+struct PageRankOptions {
+    double damping = 0.85;
+    double tolerance = 1e-6;
+    int maxIterations = 100;
+    bool singlePrecision = false;
+    List<int> restartVertices;
+    List<double> restartWeights;
+};
+
+// ranks by vertex index, they add up to one
+struct PageRankResult {
+    List<double> rank;
+    int iterations = 0;
+    double error = 0;
+};
+
+PageRankResult getPageRank(Graph& graph, const PageRankOptions& options = PageRankOptions());
+template <typename Real> PageRankResult pageRankIterations(Graph& graph, const PageRankOptions& options, vector<Real>& restart);
+
+
+// power iteration in pull form: every vertex sums the contributions of its incoming neighbors,
+// so each rank is written by one thread only and no atomics are needed
+// the mass of dangling vertices (no out edges) is spread like the restart, as if they linked to it
+PageRankResult getPageRank(Graph& graph, const PageRankOptions& options) {
+    int numVertex = graph.getNumVertex();
+
+    if (options.damping < 0 or options.damping >= 1)
+        throw runtime_error("the damping factor must be in [0, 1)");
+
+    if (options.tolerance <= 0)
+        throw runtime_error("the tolerance must be positive");
+
+    if (options.restartWeights.size() > 0 and options.restartWeights.size() != options.restartVertices.size())
+        throw runtime_error("every restart vertex needs one weight");
+
+    if (numVertex == 0)
+        return PageRankResult();
+
+    // restart distribution
+    vector<double> restart(numVertex, options.restartVertices.size() == 0 ? 1.0 / numVertex : 0.0);
+    double restartSum = 0;
+
+    for (int i = 0; i < options.restartVertices.size(); i++) {
+        int vertexIndex = graph.getVertexIndex(options.restartVertices[i]);
+        double weight = options.restartWeights.size() == 0 ? 1.0 : options.restartWeights[i];
+
+        if (vertexIndex == -1)
+            throw runtime_error("restart vertex " + to_string(options.restartVertices[i]) + " is not in the graph");
+
+        if (weight < 0)
+            throw runtime_error("restart weights must not be negative");
+
+        restart[vertexIndex] += weight;
+        restartSum += weight;
+    }
+
+    if (options.restartVertices.size() > 0) {
+        if (restartSum <= 0)
+            throw runtime_error("the restart weights must not add up to zero");
+
+        for (int i = 0; i < numVertex; i++)
+            restart[i] /= restartSum;
+    }
+
+    // the incoming views are built here, before the threads read them
+    graph.getAdjacencyView(0);
+    graph.getReverseAdjacencyView(0);
+
+    if (options.singlePrecision) {
+        vector<float> restartFloat(restart.begin(), restart.end());
+        return pageRankIterations<float>(graph, options, restartFloat);
+    }
+
+    return pageRankIterations<double>(graph, options, restart);
+}
+
+// the iterations on one floating point type, float halves the bytes moved per edge
+template <typename Real>
+PageRankResult pageRankIterations(Graph& graph, const PageRankOptions& options, vector<Real>& restart) {
+    ThreadPool& pool = ThreadPool::instance();
+    int numVertex = graph.getNumVertex();
+    Real damping = options.damping;
+    vector<Real> rank(restart), nextRank(numVertex), contribution(numVertex), inverseDegree(numVertex);
+    vector<double> partialDangling(pool.size()), partialError(pool.size());
+    PageRankResult result;
+
+    for (int i = 0; i < numVertex; i++) {
+        int degree = graph.getAdjacencyView(i).size();
+        inverseDegree[i] = degree == 0 ? 0 : Real(1) / degree;
+    }
+
+    while (result.iterations < options.maxIterations) {
+        double dangling = 0, error = 0;
+
+        fill(partialDangling.begin(), partialDangling.end(), 0.0);
+        fill(partialError.begin(), partialError.end(), 0.0);
+
+        // what every vertex sends along each of its edges, contiguous so the pull loop reads one array
+        pool.parallelFor(0, numVertex, PAGERANK_CHUNK, [&](long begin, long end, int threadId) {
+            double sum = 0;
+
+            for (long i = begin; i < end; i++) {
+                contribution[i] = rank[i] * inverseDegree[i];
+
+                if (inverseDegree[i] == 0)
+                    sum += rank[i];
+            }
+
+            partialDangling[threadId] += sum;
+        });
+
+        for (int i = 0; i < (int) partialDangling.size(); i++)
+            dangling += partialDangling[i];
+
+        Real teleport = Real(1) - damping + damping * Real(dangling);
+
+        pool.parallelFor(0, numVertex, PAGERANK_CHUNK, [&](long begin, long end, int threadId) {
+            double sum = 0;
+
+            for (long v = begin; v < end; v++) {
+                View<int> incoming = graph.getReverseAdjacencyView(v);
+                Real pulled = 0;
+
+                for (int j = 0; j < incoming.size(); j++)
+                    pulled += contribution[incoming[j]];
+
+                nextRank[v] = teleport * restart[v] + damping * pulled;
+                sum += fabs((double) nextRank[v] - rank[v]);
+            }
+
+            partialError[threadId] += sum;
+        });
+
+        for (int i = 0; i < (int) partialError.size(); i++)
+            error += partialError[i];
+
+        rank.swap(nextRank);
+        result.iterations++;
+        result.error = error;
+
+        if (error < options.tolerance)
+            break;
+    }
+
+    result.rank = List<double>(numVertex, 0.0);
+
+    for (int i = 0; i < numVertex; i++)
+        result.rank[i] = rank[i];
+
+    return result;
+}
@@ -0,0 +1,258 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#include "list.hpp"
+#include "view.hpp"
+
+using namespace std;
+
+// monotonic allocator, every block is released together with the arena
+class Arena {
+    public:
+        Arena(size_t blockSize = 1 << 16);
+        Arena(const Arena& other) = delete;
+        Arena& operator=(const Arena& other) = delete;
+        ~Arena();
+        void* allocate(size_t bytes, size_t alignment);
+        template <typename T> T* allocate(long count);
+
+    private:
+        vector<char*> blocks;
+        char* current = nullptr;
+        size_t used = 0;
+        size_t capacity = 0;
+        size_t blockSize;
+};
+
+// rows of values stored back to back, row i spans values[offsets[i], offsets[i + 1])
+template <typename T>
+class RaggedArray {
+    static_assert(is_trivially_copyable<T>::value, "arena values are never destroyed");
+
+    public:
+        RaggedArray(int rowCapacity = 0, long valueCapacity = 0);
+        RaggedArray(const List<List<T>>& lists);
+        RaggedArray(const RaggedArray<T>& other);
+        RaggedArray(RaggedArray<T>&& other);
+        RaggedArray<T>& operator=(const RaggedArray<T>& other);
+        RaggedArray<T>& operator=(RaggedArray<T>&& other);
+        View<T> operator[](const int row) const;
+        View<T> at(int row) const;
+        void append(T value);
+        void endRow();
+        void reverseRow(int row);
+        int size() const;
+        long numValues() const;
+        List<List<T>> toLists() const;
+
+    private:
+        shared_ptr<Arena> arena;
+        T* values = nullptr;
+        long* offsets = nullptr;
+        long valueCapacity = 0;
+        long numValuesStored = 0;
+        int rowCapacity = 0;
+        int numRows = 0;
+        void reserve(int rowCapacity, long valueCapacity);
+};
+
+
+Arena::Arena(size_t blockSize) {
+    this->blockSize = blockSize;
+}
+
+Arena::~Arena() {
+    for (int i = 0; i < (int) this->blocks.size(); i++)
+        delete[] this->blocks[i];
+}
+
+// bump allocation, a new block is opened when the current one is full
+void* Arena::allocate(size_t bytes, size_t alignment) {
+    size_t start = (this->used + alignment - 1) & ~(alignment - 1);
+
+    if (this->current == nullptr or start + bytes > this->capacity) {
+        size_t size = bytes + alignment > this->blockSize ? bytes + alignment : this->blockSize;
+
+        this->current = new char[size];
+        this->blocks.push_back(this->current);
+        this->capacity = size;
+        start = (alignment - ((size_t) this->current & (alignment - 1))) & (alignment - 1);
+    }
+
+    this->used = start + bytes;
+    return this->current + start;
+}
+
+template <typename T>
+T* Arena::allocate(long count) {
+    return (T*) this->allocate(count * sizeof(T), alignof(T));
+}
+
+// constructor, the capacities are upper bounds known by the caller to avoid growing
+// an empty array allocates nothing until its first row
+template <typename T>
+RaggedArray<T>::RaggedArray(int rowCapacity, long valueCapacity) {
+    if (rowCapacity > 0 or valueCapacity > 0)
+        this->reserve(rowCapacity, valueCapacity);
+}
+
+// adapter from nested lists
+template <typename T>
+RaggedArray<T>::RaggedArray(const List<List<T>>& lists) : RaggedArray(lists.size(), 0) {
+    for (int i = 0; i < lists.size(); i++) {
+        for (int j = 0; j < lists[i].size(); j++)
+            this->append(lists[i][j]);
+
+        this->endRow();
+    }
+}
+
+// copy constructor, the copy gets its own arena sized to the values stored
+// a source with only reserved capacity copies as an empty array, which allocates nothing
+template <typename T>
+RaggedArray<T>::RaggedArray(const RaggedArray<T>& other) : RaggedArray(other.numRows, other.numValuesStored) {
+    if (other.numRows > 0 or other.numValuesStored > 0) {
+        memcpy(this->offsets, other.offsets, (other.numRows + 1) * sizeof(long));
+        memcpy((void*) this->values, other.values, other.numValuesStored * sizeof(T));
+    }
+
+    this->numRows = other.numRows;
+    this->numValuesStored = other.numValuesStored;
+}
+
+// move constructor, the other array is left empty
+template <typename T>
+RaggedArray<T>::RaggedArray(RaggedArray<T>&& other) {
+    *this = move(other);
+}
+
+template <typename T>
+RaggedArray<T>& RaggedArray<T>::operator=(const RaggedArray<T>& other) {
+    if (this != &other)
+        *this = RaggedArray<T>(other);
+
+    return *this;
+}
+
+template <typename T>
+RaggedArray<T>& RaggedArray<T>::operator=(RaggedArray<T>&& other) {
+    if (this == &other)
+        return *this;
+
+    this->arena = move(other.arena);
+    this->values = other.values;
+    this->offsets = other.offsets;
+    this->valueCapacity = other.valueCapacity;
+    this->numValuesStored = other.numValuesStored;
+    this->rowCapacity = other.rowCapacity;
+    this->numRows = other.numRows;
+
+    other.values = nullptr;
+    other.offsets = nullptr;
+    other.valueCapacity = other.numValuesStored = 0;
+    other.rowCapacity = other.numRows = 0;
+
+    return *this;
+}
+
+template <typename T>
+View<T> RaggedArray<T>::operator[](const int row) const {
+    return View<T>(this->values + this->offsets[row], this->values + this->offsets[row + 1]);
+}
+
+template <typename T>
+View<T> RaggedArray<T>::at(int row) const {
+    return (*this)[row];
+}
+
+// add a value to the row being built
+template <typename T>
+void RaggedArray<T>::append(T value) {
+    if (this->numValuesStored == this->valueCapacity)
+        this->reserve(this->rowCapacity, 2 * this->valueCapacity + 16);
+
+    this->values[this->numValuesStored++] = value;
+}
+
+// close the row being built
+template <typename T>
+void RaggedArray<T>::endRow() {
+    if (this->numRows == this->rowCapacity)
+        this->reserve(2 * this->rowCapacity + 16, this->valueCapacity);
+
+    this->offsets[++this->numRows] = this->numValuesStored;
+}
+
+template <typename T>
+void RaggedArray<T>::reverseRow(int row) {
+    long first = this->offsets[row];
+    long last = this->offsets[row + 1] - 1;
+
+    while (first < last) {
+        T aux = this->values[first];
+        this->values[first++] = this->values[last];
+        this->values[last--] = aux;
+    }
+}
+
+// return the number of closed rows
+template <typename T>
+int RaggedArray<T>::size() const {
+    return this->numRows;
+}
+
+template <typename T>
+long RaggedArray<T>::numValues() const {
+    return this->numValuesStored;
+}
+
+// adapter to nested lists for callers that still need them
+template <typename T>
+List<List<T>> RaggedArray<T>::toLists() const {
+    List<List<T>> lists(this->numRows, List<T>());
+
+    for (int i = 0; i < this->numRows; i++) {
+        View<T> row = (*this)[i];
+        List<T> list(row.size(), T());
+
+        for (int j = 0; j < row.size(); j++)
+            list[j] = row[j];
+
+        lists[i] = move(list);
+    }
+
+    return lists;
+}
+
+// move the buffers that must grow to bigger ones from the same arena, the other one stays where it is
+template <typename T>
+void RaggedArray<T>::reserve(int rowCapacity, long valueCapacity) {
+    if (this->arena == nullptr)
+        this->arena = make_shared<Arena>((rowCapacity + 1) * sizeof(long) + valueCapacity * sizeof(T) + 2 * alignof(max_align_t));
+
+    if (this->offsets == nullptr or rowCapacity > this->rowCapacity) {
+        long* newOffsets = this->arena->template allocate<long>(rowCapacity + 1);
+
+        newOffsets[0] = 0;
+
+        if (this->offsets != nullptr)
+            memcpy(newOffsets, this->offsets, (this->numRows + 1) * sizeof(long));
+
+        this->offsets = newOffsets;
+        this->rowCapacity = rowCapacity;
+    }
+
+    if (this->values == nullptr or valueCapacity > this->valueCapacity) {
+        T* newValues = this->arena->template allocate<T>(valueCapacity);
+
+        if (this->values != nullptr)
+            memcpy((void*) newValues, this->values, this->numValuesStored * sizeof(T));
+
+        this->values = newValues;
+        this->valueCapacity = valueCapacity;
+    }
+}
@@ -0,0 +1,186 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include "graph.hpp"
+#include "list.hpp"
+
+using namespace std;
+
+// point to point queries by bidirectional bfs, the forward search follows the edges and the
+// backward search follows them reversed, a level of the smaller frontier is expanded each round
+// the scratch arrays are stamped with a query epoch, so a query never clears them
+// one object per thread, the graph views must be built before sharing the graph between threads
+class ReachabilityQuery {
+    public:
+        ReachabilityQuery(Graph& graph);
+        bool reachable(int source, int destination);
+        int distance(int source, int destination);
+        List<int> path(int source, int destination);
+
+    private:
+        Graph* graph;
+        vector<unsigned int> forwardStamp;
+        vector<unsigned int> backwardStamp;
+        vector<int> forwardDistance;
+        vector<int> backwardDistance;
+        vector<int> forwardParent;
+        vector<int> backwardParent;
+        vector<int> frontier;
+        vector<int> backwardFrontier;
+        vector<int> nextFrontier;
+        unsigned int epoch = 0;
+        int meetingIndex = -1;
+        int search(int sourceIndex, int destinationIndex);
+        bool expand(vector<int>& frontier, bool forward, int& bestDistance);
+        void nextEpoch();
+};
+
+
+// constructor, the query keeps a reference to the graph
+ReachabilityQuery::ReachabilityQuery(Graph& graph) {
+    this->graph = &graph;
+}
+
+bool ReachabilityQuery::reachable(int source, int destination) {
+    return this->distance(source, destination) != -1;
+}
+
+// return the number of edges of a shortest path, -1 if there is none
+int ReachabilityQuery::distance(int source, int destination) {
+    int sourceIndex = this->graph->getVertexIndex(source);
+    int destinationIndex = this->graph->getVertexIndex(destination);
+
+    if (sourceIndex == -1 or destinationIndex == -1)
+        return -1;
+
+    return this->search(sourceIndex, destinationIndex);
+}
+
+// return the vertex of a shortest path from source to destination, empty if there is none
+List<int> ReachabilityQuery::path(int source, int destination) {
+    List<int> path;
+    int sourceIndex = this->graph->getVertexIndex(source);
+    int destinationIndex = this->graph->getVertexIndex(destination);
+
+    if (sourceIndex == -1 or destinationIndex == -1)
+        return path;
+
+    int distance = this->search(sourceIndex, destinationIndex);
+
+    if (distance == -1)
+        return path;
+
+    List<int> indexList(distance + 1, 0);
+    int position = this->forwardDistance[this->meetingIndex];
+
+    // walk back to the source from the meeting vertex, then forward to the destination
+    for (int index = this->meetingIndex, i = position; i >= 0; index = this->forwardParent[index], i--)
+        indexList[i] = index;
+
+    for (int index = this->meetingIndex, i = position; i <= distance; index = this->backwardParent[index], i++)
+        indexList[i] = index;
+
+    path.reserve(distance + 1);
+
+    for (int i = 0; i <= distance; i++)
+        path.insert(this->graph->vertexAt(indexList[i]));
+
+    return path;
+}
+
+int ReachabilityQuery::search(int sourceIndex, int destinationIndex) {
+    int bestDistance = -1;
+
+    this->nextEpoch();
+    this->meetingIndex = -1;
+
+    this->forwardStamp[sourceIndex] = this->epoch;
+    this->forwardDistance[sourceIndex] = 0;
+    this->forwardParent[sourceIndex] = -1;
+    this->backwardStamp[destinationIndex] = this->epoch;
+    this->backwardDistance[destinationIndex] = 0;
+    this->backwardParent[destinationIndex] = -1;
+
+    if (sourceIndex == destinationIndex) {
+        this->meetingIndex = sourceIndex;
+        return 0;
+    }
+
+    this->frontier.assign(1, sourceIndex);
+    this->backwardFrontier.assign(1, destinationIndex);
+
+    // a whole level is expanded before stopping, so the best meeting found in it is a shortest path
+    while (!this->frontier.empty() and !this->backwardFrontier.empty()) {
+        bool met;
+
+        if (this->frontier.size() <= this->backwardFrontier.size())
+            met = this->expand(this->frontier, true, bestDistance);
+        else
+            met = this->expand(this->backwardFrontier, false, bestDistance);
+
+        if (met)
+            return bestDistance;
+    }
+
+    return -1;
+}
+
+// expand one level of a frontier, return true if it touched the other search
+bool ReachabilityQuery::expand(vector<int>& frontier, bool forward, int& bestDistance) {
+    vector<unsigned int>& stamp = forward ? this->forwardStamp : this->backwardStamp;
+    vector<unsigned int>& otherStamp = forward ? this->backwardStamp : this->forwardStamp;
+    vector<int>& distance = forward ? this->forwardDistance : this->backwardDistance;
+    vector<int>& otherDistance = forward ? this->backwardDistance : this->forwardDistance;
+    vector<int>& parent = forward ? this->forwardParent : this->backwardParent;
+    bool met = false;
+
+    this->nextFrontier.clear();
+
+    for (int i = 0; i < (int) frontier.size(); i++) {
+        int vertexIndex = frontier[i];
+        View<int> adjacency = forward ? this->graph->getAdjacencyView(vertexIndex) : this->graph->getReverseAdjacencyView(vertexIndex);
+
+        for (int j = 0; j < adjacency.size(); j++) {
+            int adjIndex = adjacency[j];
+
+            if (stamp[adjIndex] == this->epoch)
+                continue;
+
+            stamp[adjIndex] = this->epoch;
+            distance[adjIndex] = distance[vertexIndex] + 1;
+            parent[adjIndex] = vertexIndex;
+            this->nextFrontier.push_back(adjIndex);
+
+            if (otherStamp[adjIndex] == this->epoch) {
+                int total = distance[adjIndex] + otherDistance[adjIndex];
+
+                if (!met or total < bestDistance) {
+                    bestDistance = total;
+                    this->meetingIndex = adjIndex;
+                }
+
+                met = true;
+            }
+        }
+    }
+
+    frontier.swap(this->nextFrontier);
+    return met;
+}
+
+// start a new query, the arrays follow the graph size and are cleared only when the epoch wraps
+void ReachabilityQuery::nextEpoch() {
+    int numVertex = this->graph->getNumVertex();
+
+    if ((int) this->forwardStamp.size() != numVertex or this->epoch == 0xffffffffu) {
+        this->forwardStamp.assign(numVertex, 0);
+        this->backwardStamp.assign(numVertex, 0);
+        this->forwardDistance.resize(numVertex);
+        this->backwardDistance.resize(numVertex);
+        this->forwardParent.resize(numVertex);
+        this->backwardParent.resize(numVertex);
+        this->epoch = 0;
+    }
+
+    this->epoch++;
+}
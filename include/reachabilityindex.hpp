@@ -0,0 +1,376 @@
+#pragma once
+#include <iostream>
+#include <exception>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "graph.hpp"
+#include "digraph.hpp"
+#include "bufferedwriter.hpp"
+
+using namespace std;
+
+// number of hot vertex whose closure is kept exactly, one bit each
+#define REACHABILITY_HOT_SET 64
+
+// reachability index of a dag, queries are answered by cheap cuts and fall back to a pruned dfs
+//  - topological levels: an edge always goes to a higher level
+//  - grail intervals: each random dfs labels a vertex with [lowest post order below it, its post order],
+//    the intervals of a reachable vertex are contained in the ones of the vertex reaching it
+//  - hot set: exact bits of which hot vertex each vertex reaches and is reached by
+class ReachabilityIndex {
+    public:
+        ReachabilityIndex(Digraph& digraph, int numLabels = 3);
+        static ReachabilityIndex load(Digraph& digraph, string filePath);
+        void save(string filePath) const;
+        bool reachable(int source, int destination);
+        int getNumLabels() const;
+        long getNumSearches() const;
+
+    private:
+        Digraph* digraph;
+        int numVertex = 0;
+        int numLabels = 0;
+        unsigned long long fingerprint = 0;
+        vector<int> level;
+        vector<int> low;
+        vector<int> post;
+        vector<unsigned long long> hotDescendants;
+        vector<unsigned long long> hotAncestors;
+        vector<unsigned int> stamp;
+        vector<int> stack;
+        unsigned int epoch = 0;
+        long numSearches = 0;
+        ReachabilityIndex() = default;
+        void buildLabels(const vector<int>& order);
+        void buildHotSet(const vector<int>& order);
+        bool mayReach(int sourceIndex, int destinationIndex) const;
+        bool search(int sourceIndex, int destinationIndex);
+        static unsigned long long graphFingerprint(Digraph& digraph);
+};
+
+
+// constructor, throw if the digraph has a cycle
+ReachabilityIndex::ReachabilityIndex(Digraph& digraph, int numLabels) {
+    this->digraph = &digraph;
+    this->numVertex = digraph.getNumVertex();
+    this->numLabels = numLabels;
+    this->fingerprint = ReachabilityIndex::graphFingerprint(digraph);
+
+    int numVertex = this->numVertex;
+    vector<int> inDegree(numVertex), order;
+
+    // kahn over the vertex indexes
+    order.reserve(numVertex);
+
+    for (int i = 0; i < numVertex; i++) {
+        inDegree[i] = digraph.getReverseAdjacencyView(i).size();
+
+        if (inDegree[i] == 0)
+            order.push_back(i);
+    }
+
+    for (int head = 0; head < (int) order.size(); head++) {
+        View<int> adjacency = digraph.getAdjacencyView(order[head]);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            if (--inDegree[adjacency[j]] == 0)
+                order.push_back(adjacency[j]);
+    }
+
+    if ((int) order.size() != numVertex)
+        throw runtime_error("the reachability index requires an acyclic digraph");
+
+    this->level.assign(numVertex, 0);
+
+    for (int i = 0; i < numVertex; i++) {
+        View<int> adjacency = digraph.getAdjacencyView(order[i]);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            this->level[adjacency[j]] = max(this->level[adjacency[j]], this->level[order[i]] + 1);
+    }
+
+    this->buildLabels(order);
+    this->buildHotSet(order);
+}
+
+// read an index saved for this same digraph
+ReachabilityIndex ReachabilityIndex::load(Digraph& digraph, string filePath) {
+    ReachabilityIndex index;
+    ifstream input(filePath, ios::binary);
+    char magic[8];
+
+    if (!input.is_open())
+        throw runtime_error("failed to open the reachability index file");
+
+    input.read(magic, sizeof(magic));
+    input.read((char*) &index.fingerprint, sizeof(index.fingerprint));
+    input.read((char*) &index.numVertex, sizeof(index.numVertex));
+    input.read((char*) &index.numLabels, sizeof(index.numLabels));
+
+    if (!input or string(magic, sizeof(magic)) != "DAGINDX1" or index.numVertex != digraph.getNumVertex() or
+        index.numLabels <= 0 or index.fingerprint != ReachabilityIndex::graphFingerprint(digraph))
+        throw runtime_error("the reachability index file does not match the digraph");
+
+    long numLabels = (long) index.numVertex * index.numLabels;
+
+    index.digraph = &digraph;
+    index.level.resize(index.numVertex);
+    index.low.resize(numLabels);
+    index.post.resize(numLabels);
+    index.hotDescendants.resize(index.numVertex);
+    index.hotAncestors.resize(index.numVertex);
+
+    input.read((char*) index.level.data(), index.level.size() * sizeof(int));
+    input.read((char*) index.low.data(), index.low.size() * sizeof(int));
+    input.read((char*) index.post.data(), index.post.size() * sizeof(int));
+    input.read((char*) index.hotDescendants.data(), index.hotDescendants.size() * sizeof(unsigned long long));
+    input.read((char*) index.hotAncestors.data(), index.hotAncestors.size() * sizeof(unsigned long long));
+
+    if (!input)
+        throw runtime_error("the reachability index file is truncated");
+
+    return index;
+}
+
+// binary layout: magic, fingerprint, sizes, then every array in native byte order
+void ReachabilityIndex::save(string filePath) const {
+    BufferedWriter output(filePath);
+
+    output.write("DAGINDX1", 8);
+    output.write((const char*) &this->fingerprint, sizeof(this->fingerprint));
+    output.write((const char*) &this->numVertex, sizeof(this->numVertex));
+    output.write((const char*) &this->numLabels, sizeof(this->numLabels));
+    output.write((const char*) this->level.data(), this->level.size() * sizeof(int));
+    output.write((const char*) this->low.data(), this->low.size() * sizeof(int));
+    output.write((const char*) this->post.data(), this->post.size() * sizeof(int));
+    output.write((const char*) this->hotDescendants.data(), this->hotDescendants.size() * sizeof(unsigned long long));
+    output.write((const char*) this->hotAncestors.data(), this->hotAncestors.size() * sizeof(unsigned long long));
+    output.close();
+}
+
+// return true if there is a path from source to destination, a vertex reaches itself
+bool ReachabilityIndex::reachable(int source, int destination) {
+    int sourceIndex = this->digraph->getVertexIndex(source);
+    int destinationIndex = this->digraph->getVertexIndex(destination);
+
+    if (sourceIndex == -1 or destinationIndex == -1)
+        return false;
+
+    if (sourceIndex == destinationIndex)
+        return true;
+
+    if (!this->mayReach(sourceIndex, destinationIndex))
+        return false;
+
+    // both go through the same hot vertex
+    if (this->hotDescendants[sourceIndex] & this->hotAncestors[destinationIndex])
+        return true;
+
+    return this->search(sourceIndex, destinationIndex);
+}
+
+int ReachabilityIndex::getNumLabels() const {
+    return this->numLabels;
+}
+
+// return the number of queries no cut could answer
+long ReachabilityIndex::getNumSearches() const {
+    return this->numSearches;
+}
+
+// one random post order traversal per label, the first one keeps the natural order
+void ReachabilityIndex::buildLabels(const vector<int>& order) {
+    int numVertex = this->numVertex;
+    vector<int> roots, position(numVertex);
+    vector<char> visited(numVertex);
+    vector<pair<int, int>> stack;
+    mt19937 generator(numVertex);
+
+    this->low.assign((long) numVertex * this->numLabels, 0);
+    this->post.assign((long) numVertex * this->numLabels, 0);
+
+    for (int i = 0; i < numVertex; i++)
+        if (this->digraph->getReverseAdjacencyView(order[i]).size() == 0)
+            roots.push_back(order[i]);
+
+    for (int k = 0; k < this->numLabels; k++) {
+        int rank = 0;
+
+        if (k > 0)
+            shuffle(roots.begin(), roots.end(), generator);
+
+        fill(visited.begin(), visited.end(), 0);
+
+        for (int r = 0; r < (int) roots.size(); r++) {
+            stack.push_back(make_pair(roots[r], 0));
+            visited[roots[r]] = 1;
+
+            while (!stack.empty()) {
+                int vertexIndex = stack.back().first;
+                int& next = stack.back().second;
+                View<int> adjacency = this->digraph->getAdjacencyView(vertexIndex);
+
+                // the children are walked from a rotated start, so each label takes other branches first
+                if (next == 0 and k > 0 and adjacency.size() > 1)
+                    position[vertexIndex] = generator() % adjacency.size();
+                else if (next == 0)
+                    position[vertexIndex] = 0;
+
+                if (next < adjacency.size()) {
+                    int adjIndex = adjacency[(position[vertexIndex] + next) % adjacency.size()];
+                    next++;
+
+                    if (!visited[adjIndex]) {
+                        visited[adjIndex] = 1;
+                        stack.push_back(make_pair(adjIndex, 0));
+                    }
+
+                    continue;
+                }
+
+                long label = (long) vertexIndex * this->numLabels + k;
+                int lowest = rank;
+
+                for (int j = 0; j < adjacency.size(); j++)
+                    lowest = min(lowest, this->low[(long) adjacency[j] * this->numLabels + k]);
+
+                this->low[label] = lowest;
+                this->post[label] = rank++;
+                stack.pop_back();
+            }
+        }
+    }
+}
+
+// the hot set is made of the vertex with the most paths through them, estimated by in * out degree
+void ReachabilityIndex::buildHotSet(const vector<int>& order) {
+    int numVertex = this->numVertex;
+    vector<int> candidates(numVertex);
+
+    for (int i = 0; i < numVertex; i++)
+        candidates[i] = i;
+
+    auto score = [&](int vertexIndex) {
+        return (long) (this->digraph->getAdjacencyView(vertexIndex).size() + 1) *
+            (this->digraph->getReverseAdjacencyView(vertexIndex).size() + 1);
+    };
+
+    int numHot = min(numVertex, REACHABILITY_HOT_SET);
+
+    partial_sort(candidates.begin(), candidates.begin() + numHot, candidates.end(), [&](int a, int b) {
+        return score(a) > score(b);
+    });
+
+    this->hotDescendants.assign(numVertex, 0);
+    this->hotAncestors.assign(numVertex, 0);
+
+    for (int h = 0; h < numHot; h++) {
+        this->hotDescendants[candidates[h]] |= 1ULL << h;
+        this->hotAncestors[candidates[h]] |= 1ULL << h;
+    }
+
+    // descendants flow up against the topological order, ancestors flow down along it
+    for (int i = numVertex - 1; i >= 0; i--) {
+        View<int> adjacency = this->digraph->getAdjacencyView(order[i]);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            this->hotDescendants[order[i]] |= this->hotDescendants[adjacency[j]];
+    }
+
+    for (int i = 0; i < numVertex; i++) {
+        View<int> adjacency = this->digraph->getAdjacencyView(order[i]);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            this->hotAncestors[adjacency[j]] |= this->hotAncestors[order[i]];
+    }
+}
+
+// false when some cut proves that source does not reach destination
+bool ReachabilityIndex::mayReach(int sourceIndex, int destinationIndex) const {
+    if (this->level[sourceIndex] >= this->level[destinationIndex])
+        return false;
+
+    if (this->hotDescendants[destinationIndex] & ~this->hotDescendants[sourceIndex])
+        return false;
+
+    if (this->hotAncestors[sourceIndex] & ~this->hotAncestors[destinationIndex])
+        return false;
+
+    const int* sourceLow = this->low.data() + (long) sourceIndex * this->numLabels;
+    const int* sourcePost = this->post.data() + (long) sourceIndex * this->numLabels;
+    const int* destinationLow = this->low.data() + (long) destinationIndex * this->numLabels;
+    const int* destinationPost = this->post.data() + (long) destinationIndex * this->numLabels;
+
+    for (int k = 0; k < this->numLabels; k++)
+        if (destinationLow[k] < sourceLow[k] or destinationPost[k] > sourcePost[k])
+            return false;
+
+    return true;
+}
+
+// dfs that only enters vertex the cuts can not rule out
+bool ReachabilityIndex::search(int sourceIndex, int destinationIndex) {
+    if ((int) this->stamp.size() != this->numVertex or this->epoch == 0xffffffffu) {
+        this->stamp.assign(this->numVertex, 0);
+        this->epoch = 0;
+    }
+
+    this->epoch++;
+    this->numSearches++;
+    this->stack.assign(1, sourceIndex);
+    this->stamp[sourceIndex] = this->epoch;
+
+    while (!this->stack.empty()) {
+        int vertexIndex = this->stack.back();
+        View<int> adjacency = this->digraph->getAdjacencyView(vertexIndex);
+
+        this->stack.pop_back();
+
+        for (int j = 0; j < adjacency.size(); j++) {
+            int adjIndex = adjacency[j];
+
+            if (adjIndex == destinationIndex)
+                return true;
+
+            if (this->stamp[adjIndex] == this->epoch)
+                continue;
+
+            this->stamp[adjIndex] = this->epoch;
+
+            if (this->mayReach(adjIndex, destinationIndex))
+                this->stack.push_back(adjIndex);
+        }
+    }
+
+    return false;
+}
+
+// fnv-1a over the vertex and edge lists, ties a saved index to the digraph it was built for
+unsigned long long ReachabilityIndex::graphFingerprint(Digraph& digraph) {
+    View<int> vertexList = digraph.getVertexView();
+    View<Edge> edgeList = digraph.getEdgeView();
+    unsigned long long hash = 14695981039346656037ULL;
+
+    auto mix = [&](unsigned int value) {
+        for (int i = 0; i < 4; i++) {
+            hash ^= (value >> (8 * i)) & 0xff;
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    mix(vertexList.size());
+    mix(edgeList.size());
+
+    for (int i = 0; i < vertexList.size(); i++)
+        mix(vertexList[i]);
+
+    for (int i = 0; i < edgeList.size(); i++) {
+        mix(edgeList[i].getSource());
+        mix(edgeList[i].getDestination());
+    }
+
+    return hash;
+}
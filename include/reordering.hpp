@@ -0,0 +1,312 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <algorithm>
+#include "graph.hpp"
+#include "list.hpp"
+
+#ifdef __linux__
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+#endif
+
+using namespace std;
+using namespace chrono;
+
+// orders that place vertices visited together next to each other in the dense indexes
+//   ORDER_RCM     reverse cuthill-mckee, small bandwidth, good for sparse meshes and road networks
+//   ORDER_BFS     breadth first order, neighbors of a vertex share a few cache lines
+//   ORDER_DEGREE  highest degree first, the hot vertices of skewed graphs share the cache
+enum VertexOrder {ORDER_RCM, ORDER_BFS, ORDER_DEGREE};
+
+// hardware cache misses of the calling thread, -1 when the counters are not available
+// (not linux, no pmu in a virtual machine or perf_event_paranoid forbids it)
+class CacheMissCounter {
+    public:
+        CacheMissCounter();
+        CacheMissCounter(const CacheMissCounter& other) = delete;
+        CacheMissCounter& operator=(const CacheMissCounter& other) = delete;
+        ~CacheMissCounter();
+        void start();
+        long long stop();
+
+    private:
+        int fileDescriptor = -1;
+};
+
+struct ReorderingReport {
+    double secondsBefore;
+    double secondsAfter;
+    long long cacheMissesBefore;
+    long long cacheMissesAfter;
+    long bandwidthBefore;
+    long bandwidthAfter;
+};
+
+List<int> getVertexOrder(Graph& graph, VertexOrder order);
+void reorderVertices(Graph& graph, VertexOrder order);
+long getIndexBandwidth(Graph& graph);
+ReorderingReport benchmarkReordering(Graph& graph, VertexOrder order, int rounds = 3);
+
+
+CacheMissCounter::CacheMissCounter() {
+#ifdef __linux__
+    struct perf_event_attr attributes;
+
+    memset(&attributes, 0, sizeof(attributes));
+    attributes.type = PERF_TYPE_HARDWARE;
+    attributes.size = sizeof(attributes);
+    attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+    attributes.disabled = 1;
+    attributes.exclude_kernel = 1;
+    attributes.exclude_hv = 1;
+
+    this->fileDescriptor = syscall(__NR_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+}
+
+CacheMissCounter::~CacheMissCounter() {
+#ifdef __linux__
+    if (this->fileDescriptor >= 0)
+        close(this->fileDescriptor);
+#endif
+}
+
+void CacheMissCounter::start() {
+#ifdef __linux__
+    if (this->fileDescriptor < 0)
+        return;
+
+    ioctl(this->fileDescriptor, PERF_EVENT_IOC_RESET, 0);
+    ioctl(this->fileDescriptor, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+}
+
+// return the misses since start
+long long CacheMissCounter::stop() {
+#ifdef __linux__
+    long long count;
+
+    if (this->fileDescriptor < 0)
+        return -1;
+
+    ioctl(this->fileDescriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+    if (read(this->fileDescriptor, &count, sizeof(count)) != sizeof(count))
+        return -1;
+
+    return count;
+#else
+    return -1;
+#endif
+}
+
+// return the old index of the vertex that goes to each new index
+// edges of a digraph are followed both ways, locality does not depend on their direction
+List<int> getVertexOrder(Graph& graph, VertexOrder order) {
+    int numVertex = graph.getNumVertex();
+    vector<int> degree(numVertex);
+    List<int> orderList;
+
+    orderList.reserve(numVertex);
+
+    for (int i = 0; i < numVertex; i++) {
+        degree[i] = graph.getAdjacencyView(i).size();
+
+        if (graph.directed())
+            degree[i] += graph.getReverseAdjacencyView(i).size();
+    }
+
+    if (order == ORDER_DEGREE) {
+        vector<int> indexList(numVertex);
+
+        for (int i = 0; i < numVertex; i++)
+            indexList[i] = i;
+
+        stable_sort(indexList.begin(), indexList.end(), [&](int a, int b) {
+            return degree[a] > degree[b];
+        });
+
+        for (int i = 0; i < numVertex; i++)
+            orderList.insert(indexList[i]);
+
+        return orderList;
+    }
+
+    vector<char> visited(numVertex, 0);
+    vector<int> roots(numVertex);
+    vector<int> neighbors;
+
+    // rcm starts every component from a vertex of minimum degree, near the border of the graph
+    for (int i = 0; i < numVertex; i++)
+        roots[i] = i;
+
+    if (order == ORDER_RCM)
+        stable_sort(roots.begin(), roots.end(), [&](int a, int b) {
+            return degree[a] < degree[b];
+        });
+
+    for (int r = 0; r < numVertex; r++) {
+        int head = orderList.size();
+
+        if (visited[roots[r]])
+            continue;
+
+        visited[roots[r]] = 1;
+        orderList.insert(roots[r]);
+
+        // the order list itself is the queue
+        while (head < orderList.size()) {
+            int vertexIndex = orderList[head++];
+            View<int> adjacency = graph.getAdjacencyView(vertexIndex);
+
+            neighbors.clear();
+
+            for (int j = 0; j < adjacency.size(); j++)
+                if (!visited[adjacency[j]]) {
+                    visited[adjacency[j]] = 1;
+                    neighbors.push_back(adjacency[j]);
+                }
+
+            if (graph.directed()) {
+                View<int> reverseAdjacency = graph.getReverseAdjacencyView(vertexIndex);
+
+                for (int j = 0; j < reverseAdjacency.size(); j++)
+                    if (!visited[reverseAdjacency[j]]) {
+                        visited[reverseAdjacency[j]] = 1;
+                        neighbors.push_back(reverseAdjacency[j]);
+                    }
+            }
+
+            if (order == ORDER_RCM)
+                stable_sort(neighbors.begin(), neighbors.end(), [&](int a, int b) {
+                    return degree[a] < degree[b];
+                });
+
+            for (int j = 0; j < (int) neighbors.size(); j++)
+                orderList.insert(neighbors[j]);
+        }
+    }
+
+    // the reversal is what makes it reverse cuthill-mckee, the fill stays closer to the diagonal
+    if (order == ORDER_RCM)
+        for (int i = 0, j = numVertex - 1; i < j; i++, j--) {
+            int aux = orderList[i];
+            orderList[i] = orderList[j];
+            orderList[j] = aux;
+        }
+
+    return orderList;
+}
+
+// renumber the dense indexes of the graph, the vertex ids stay the same
+void reorderVertices(Graph& graph, VertexOrder order) {
+    graph.permuteVertices(getVertexOrder(graph, order));
+}
+
+// largest distance between the indexes of the endpoints of an edge
+long getIndexBandwidth(Graph& graph) {
+    long bandwidth = 0;
+
+    for (int i = 0; i < graph.getNumVertex(); i++) {
+        View<int> adjacency = graph.getAdjacencyView(i);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            bandwidth = max(bandwidth, (long) abs(adjacency[j] - i));
+    }
+
+    return bandwidth;
+}
+
+// traversal workload of the benchmark, a full bfs and a sweep that reads a value of every neighbor
+// return a checksum so the compiler keeps the work
+long reorderingWorkload(Graph& graph, vector<int>& queue, vector<char>& visited, vector<long>& value) {
+    int numVertex = graph.getNumVertex();
+    long checksum = 0;
+
+    fill(visited.begin(), visited.end(), 0);
+
+    for (int r = 0; r < numVertex; r++) {
+        int head = 0;
+
+        if (visited[r])
+            continue;
+
+        queue.clear();
+        visited[r] = 1;
+        queue.push_back(r);
+
+        while (head < (int) queue.size()) {
+            View<int> adjacency = graph.getAdjacencyView(queue[head++]);
+
+            for (int j = 0; j < adjacency.size(); j++)
+                if (!visited[adjacency[j]]) {
+                    visited[adjacency[j]] = 1;
+                    queue.push_back(adjacency[j]);
+                }
+        }
+
+        checksum += head;
+    }
+
+    for (int i = 0; i < numVertex; i++) {
+        View<int> adjacency = graph.getAdjacencyView(i);
+
+        for (int j = 0; j < adjacency.size(); j++)
+            checksum += value[adjacency[j]];
+    }
+
+    return checksum;
+}
+
+// time the workload and count its cache misses before and after reordering the graph
+// the views are built before measuring, so only the traversals are compared; the best round is kept
+ReorderingReport benchmarkReordering(Graph& graph, VertexOrder order, int rounds) {
+    ReorderingReport report;
+    CacheMissCounter counter;
+    int numVertex = graph.getNumVertex();
+    vector<int> queue;
+    vector<char> visited(numVertex);
+    vector<long> value(numVertex);
+    volatile long checksum = 0;
+
+    queue.reserve(numVertex);
+
+    for (int i = 0; i < numVertex; i++)
+        value[i] = i;
+
+    for (int pass = 0; pass < 2; pass++) {
+        double bestSeconds = -1;
+        long long bestMisses = -1;
+
+        if (pass == 1)
+            reorderVertices(graph, order);
+
+        (pass == 0 ? report.bandwidthBefore : report.bandwidthAfter) = getIndexBandwidth(graph);
+
+        for (int round = 0; round < rounds; round++) {
+            time_point<steady_clock> start = steady_clock::now();
+
+            counter.start();
+            checksum = checksum + reorderingWorkload(graph, queue, visited, value);
+            long long misses = counter.stop();
+
+            double seconds = duration<double>(steady_clock::now() - start).count();
+
+            if (bestSeconds < 0 or seconds < bestSeconds)
+                bestSeconds = seconds;
+
+            if (misses >= 0 and (bestMisses < 0 or misses < bestMisses))
+                bestMisses = misses;
+        }
+
+        (pass == 0 ? report.secondsBefore : report.secondsAfter) = bestSeconds;
+        (pass == 0 ? report.cacheMissesBefore : report.cacheMissesAfter) = bestMisses;
+    }
+
+    return report;
+}
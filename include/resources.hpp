@@ -4,8 +4,12 @@
 #include <fstream>
 #include <string>
 #include <ctime>
+#include <vector>
+#include <cmath>
+#include <cstdio>
 #include "graph.hpp"
 #include "digraph.hpp"
+#include "bufferedwriter.hpp"
 
 using namespace std;
 
@@ -21,22 +25,12 @@ using namespace std;
     #define OUTPUT_BUFFER " > /dev/null 2> /dev/null &"
 #endif
 
-// rgb random colors
-const int numColors = 20;
-
-// this aproach will be replaced for a random rgb generator function
-const string colors[numColors] = {
-    "#33a8c7","#a0e426","#9336fd","#fdf148","#ffab00",
-    "#f77976","#f77976","#f050ae","#f050ae","#d883ff",
-    "#52e3e1","#52e3e1","#00f5d4","#00bbf9","#f15bb50",
-    "#9b5de5","#00bbf9","#00f5d4","#00bbf9","#f15bb50"
-};
-
 // functions prototypes
 Graph* generateGraphFromFile(string filePath, bool directGraph);
-void generateGraphImage(Graph graph, string engine = "fdp", string title = "", List<List<int>>* components = nullptr);
+void generateGraphImage(Graph graph, string engine = "fdp", string title = "", const RaggedArray<int>* components = nullptr);
 void generateGraphText(Graph graph, string filePath);
 string generateGraphFileName(string extension, bool digraph);
+string generateColor(int index);
 
 
 // open the file in filepath and parse it in a new graph object
@@ -128,10 +122,9 @@ Graph* generateGraphFromFile(string filePath, bool directGraph) {
 }
 
 // generate a image from graph object
-void generateGraphImage(Graph graph, string engine, string title, List<List<int>>* components) {
-    List<int> vertexList = graph.getVertexList();
+void generateGraphImage(Graph graph, string engine, string title, const RaggedArray<int>* components) {
     List<int> aloneVertexList = graph.getVertexAloneList();
-    List<Edge> edgeList = graph.getEdgeList();
+    View<Edge> edgeView = graph.getEdgeView();
 
     string command;
     string imagePath = "./data/images/" + generateGraphFileName("png", graph.directed());
@@ -143,23 +136,17 @@ void generateGraphImage(Graph graph, string engine, string title, List<List<int>
 
     // components 
     if (components != nullptr) {
-        int numComponents = components->size();
-
-        if (numComponents > numColors) {
-            cout << "there are not enough colors to print the graph" << endl;
-            return;
-        }
-
-        for (int i = 0; i < numComponents; i++) {
-            List<int> component = components->at(i);
+        for (int i = 0; i < components->size(); i++) {
+            View<int> component = components->at(i);
+            string color = generateColor(i);
 
             for (int j = 0; j < component.size(); j++)
-                output << component[j] <<" [fillcolor=\"" << colors[i] << "\" style=filled];";
+                output << component[j] <<" [fillcolor=\"" << color << "\" style=filled];";
         }
     }
     
-    while (edgeList.size() > 0) {
-        Edge next = edgeList.removeFirst();
+    for (int i = 0; i < edgeView.size(); i++) {
+        const Edge& next = edgeView[i];
 
         output << next.getSource();
         graph.directed() ? output << " -> " : output << " -- ";
@@ -168,11 +155,6 @@ void generateGraphImage(Graph graph, string engine, string title, List<List<int>
         if (next.hasWeight())
             output << "[label=\"" << next.getWeight() << "\"]";
         output << ";";
-
-        if (!graph.directed()) {
-            next.reverse();
-            edgeList.remove(next);
-        }
     }
 
     for (int i = 0; i < aloneVertexList.size(); i++) 
@@ -190,66 +172,64 @@ void generateGraphImage(Graph graph, string engine, string title, List<List<int>
     cout << "image created successfully" << endl;
 }
 
-// generate text file from graph object
+// generate text file from graph object, streamed in edge list order
 void generateGraphText(Graph graph, string filePath) {
-    List<int> vertexList = graph.getVertexList();
-    List<Edge> edgeList;
-    List<int> weightList;
-
-    ofstream output(filePath, ios::trunc);
-    stringstream buffer;
+    View<int> vertexList = graph.getVertexView();
+    View<Edge> edgeView = graph.getEdgeView();
+    BufferedWriter output(filePath);
+    bool weighted = false;
+    bool first = true;
 
-    // get edges and weights
-    // do not collect multiple edges on a graph
-    while (graph.getNumEdges() > 0) {
-        Edge edge = graph.edgeAt(0);
+    // vertex
+    output.write("V = {", 5);
 
-        edgeList.insert(edge);
+    for (int i = 0; i < vertexList.size(); i++) {
+        if (i != 0)
+            output.write(',');
 
-        if (graph.weighted()) 
-            weightList.insert(edge.getWeight());
+        output.writeInt(vertexList[i]);
+    }
 
-        if (!graph.directed()) {
-            edge.reverse();
-            graph.removeEdge(edge);
-        }
+    // edges
+    output.write("}; A = {", 8);
 
-        graph.removeEdge(edge);
-    }
+    for (int i = 0; i < edgeView.size(); i++) {
+        const Edge& edge = edgeView[i];
 
-    // vertex
-    buffer << "V = {";
+        if (!first)
+            output.write(',');
 
-    for (int i = 0; i < vertexList.size(); i++) {
-        buffer << vertexList[i];
+        output.write('(');
+        output.writeInt(edge.getSource());
+        output.write(',');
+        output.writeInt(edge.getDestination());
+        output.write(')');
 
-        if (i != vertexList.size() - 1) 
-            buffer << ",";
+        weighted = weighted or edge.hasWeight();
+        first = false;
     }
 
-    // edges
-    buffer << "}; A = {";
+    output.write("};", 2);
 
-    for (int i = 0; i < edgeList.size(); i++) {
-        buffer << "(" << edgeList[i].getSource() << "," << edgeList[i].getDestination() << ")";
-        if (i != edgeList.size() - 1) buffer << ",";
-    }
-    
-    buffer << "};";
+    // weights, in the same order as the edges
+    if (weighted) {
+        output.write(" P = {", 6);
+        first = true;
+
+        for (int i = 0; i < edgeView.size(); i++) {
+            if (!edgeView[i].hasWeight())
+                continue;
 
-    // weights
-    if (weightList.size() > 0) {
-        buffer << " P = {";
+            if (!first)
+                output.write(',');
 
-        for (int i = 0; i < weightList.size(); i++) {
-            buffer << weightList[i];
-            if (i != weightList.size() - 1) buffer << ",";
+            output.writeInt(edgeView[i].getWeight());
+            first = false;
         }
 
-        buffer << "};";
+        output.write("};", 2);
     }
 
-    output << buffer.str();
     output.close();
 }
 
@@ -293,3 +273,30 @@ string generateGraphFileName(string extension, bool digraph) {
 
     return fileName;
 }
+
+// rgb color of the index-th group of vertex, as many as needed
+// hues advance by the golden angle so consecutive colors are far apart, saturation and value
+// cycle through three levels so colors with close hues still differ
+string generateColor(int index) {
+    double hue = fmod(index * 137.50776405, 360.0) / 60;
+    double saturation = 0.45 + 0.2 * (index % 3);
+    double value = 0.95 - 0.15 * (index / 3 % 3);
+    double chroma = value * saturation;
+    double x = chroma * (1 - fabs(fmod(hue, 2) - 1));
+    double rgb[3] = {0, 0, 0};
+    char hex[8];
+
+    switch ((int) hue) {
+        case 0: rgb[0] = chroma; rgb[1] = x; break;
+        case 1: rgb[0] = x; rgb[1] = chroma; break;
+        case 2: rgb[1] = chroma; rgb[2] = x; break;
+        case 3: rgb[1] = x; rgb[2] = chroma; break;
+        case 4: rgb[0] = x; rgb[2] = chroma; break;
+        default: rgb[0] = chroma; rgb[2] = x; break;
+    }
+
+    snprintf(hex, sizeof(hex), "#%02x%02x%02x", (int) ((rgb[0] + value - chroma) * 255 + 0.5),
+             (int) ((rgb[1] + value - chroma) * 255 + 0.5), (int) ((rgb[2] + value - chroma) * 255 + 0.5));
+
+    return hex;
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+using namespace std;
+
+// fixed set of worker threads shared by the parallel algorithms
+class ThreadPool {
+    public:
+        ThreadPool(int numThreads = 0);
+        ~ThreadPool();
+        ThreadPool(const ThreadPool& other) = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+        int size() const;
+        void parallelFor(long begin, long end, long chunkSize, function<void(long, long, int)> body);
+        void parallelFor(long begin, long end, function<void(long, long, int)> body);
+        static ThreadPool& instance();
+
+    private:
+        vector<thread> workers;
+        mutex jobMutex;
+        condition_variable jobReady;
+        condition_variable jobDone;
+        function<void(long, long, int)>* job = nullptr;
+        long jobEnd = 0;
+        long jobChunkSize = 1;
+        atomic<long> nextIndex{0};
+        int activeWorkers = 0;
+        unsigned long generation = 0;
+        bool stopping = false;
+        void workerLoop(int threadId);
+        void runChunks(int threadId);
+};
+
+// constructor, zero threads means one per hardware thread
+ThreadPool::ThreadPool(int numThreads) {
+    if (numThreads <= 0)
+        numThreads = thread::hardware_concurrency();
+
+    if (numThreads <= 0)
+        numThreads = 1;
+
+    // the calling thread also works, so it takes the id 0
+    for (int i = 1; i < numThreads; i++)
+        this->workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> lock(this->jobMutex);
+        this->stopping = true;
+    }
+
+    this->jobReady.notify_all();
+
+    for (int i = 0; i < (int) this->workers.size(); i++)
+        this->workers[i].join();
+}
+
+// return the number of threads, including the caller
+int ThreadPool::size() const {
+    return this->workers.size() + 1;
+}
+
+// shared pool used by default by every parallel algorithm
+ThreadPool& ThreadPool::instance() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// split [begin, end) in chunks handed out dynamically to the threads
+void ThreadPool::parallelFor(long begin, long end, long chunkSize, function<void(long, long, int)> body) {
+    if (begin >= end)
+        return;
+
+    if (chunkSize <= 0)
+        chunkSize = 1;
+
+    // nothing to share, run inline
+    if (this->workers.empty() or end - begin <= chunkSize) {
+        body(begin, end, 0);
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(this->jobMutex);
+        this->job = &body;
+        this->jobEnd = end;
+        this->jobChunkSize = chunkSize;
+        this->nextIndex.store(begin);
+        this->activeWorkers = this->workers.size();
+        this->generation++;
+    }
+
+    this->jobReady.notify_all();
+    this->runChunks(0);
+
+    unique_lock<mutex> lock(this->jobMutex);
+    this->jobDone.wait(lock, [this] { return this->activeWorkers == 0; });
+    this->job = nullptr;
+}
+
+// parallel for with a chunk size picked from the range and the pool size
+void ThreadPool::parallelFor(long begin, long end, function<void(long, long, int)> body) {
+    long chunkSize = (end - begin) / (this->size() * 8);
+
+    if (chunkSize < 1)
+        chunkSize = 1;
+
+    this->parallelFor(begin, end, chunkSize, body);
+}
+
+void ThreadPool::workerLoop(int threadId) {
+    unsigned long seenGeneration = 0;
+
+    while (true) {
+        {
+            unique_lock<mutex> lock(this->jobMutex);
+            this->jobReady.wait(lock, [&] { return this->stopping or this->generation != seenGeneration; });
+
+            if (this->stopping)
+                return;
+
+            seenGeneration = this->generation;
+        }
+
+        this->runChunks(threadId);
+
+        {
+            lock_guard<mutex> lock(this->jobMutex);
+            this->activeWorkers--;
+        }
+
+        this->jobDone.notify_one();
+    }
+}
+
+void ThreadPool::runChunks(int threadId) {
+    while (true) {
+        long chunkBegin = this->nextIndex.fetch_add(this->jobChunkSize);
+
+        if (chunkBegin >= this->jobEnd)
+            return;
+
+        long chunkEnd = chunkBegin + this->jobChunkSize;
+
+        if (chunkEnd > this->jobEnd)
+            chunkEnd = this->jobEnd;
+
+        (*this->job)(chunkBegin, chunkEnd, threadId);
+    }
+}
@@ -0,0 +1,336 @@
+#pragma once
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include "graph.hpp"
+#include "list.hpp"
+#include "threadpool.hpp"
+
+using namespace std;
+
+// vertices handed to a thread at a time, small so a few hubs do not leave the other threads idle
+#define TRIANGLE_CHUNK 64
+
+#if defined(__GNUC__)
+    // eight ints compared at once by the sorted set intersection
+    typedef int TriangleLane __attribute__((vector_size(32)));
+    #define TRIANGLE_LANE_WIDTH 8
+#endif
+
+// triangles and clustering coefficients of the simple undirected graph under a graph
+// edge directions, parallel edges and self loops are ignored
+// every edge is oriented from the lower to the higher (degree, index) rank, so each triangle
+// is found once, from its lowest vertex, and no vertex keeps more than sqrt(2m) higher neighbors
+class TriangleCounter {
+    public:
+        TriangleCounter(Graph& graph);
+        long countTriangles();
+        List<long> getVertexTriangles();
+        List<double> getLocalClusteringCoefficients();
+        double getGlobalClusteringCoefficient();
+        double getAverageClusteringCoefficient();
+
+    private:
+        int numVertex;
+        vector<int> degree;
+        vector<int> rank;
+        vector<long> offset;
+        vector<int> higher;
+        long numTriangles = -1;
+        List<long> vertexTriangles;
+};
+
+long countSortedIntersection(const int* a, int sizeA, const int* b, int sizeB);
+template <typename Callback> void forEachSortedIntersection(const int* a, int sizeA, const int* b, int sizeB, Callback callback);
+
+
+// constructor, builds the oriented adjacency by rank
+TriangleCounter::TriangleCounter(Graph& graph) {
+    vector<long> simpleOffset;
+    vector<int> simple, order;
+
+    this->numVertex = graph.getNumVertex();
+    this->degree.assign(this->numVertex, 0);
+    simpleOffset.assign(this->numVertex + 1, 0);
+
+    // distinct neighbors of every vertex, in both directions for digraphs
+    for (int i = 0; i < this->numVertex; i++) {
+        View<int> adjacency = graph.getAdjacencyView(i);
+        long first = simple.size();
+
+        simple.insert(simple.end(), adjacency.begin(), adjacency.end());
+
+        if (graph.directed()) {
+            View<int> reverseAdjacency = graph.getReverseAdjacencyView(i);
+            simple.insert(simple.end(), reverseAdjacency.begin(), reverseAdjacency.end());
+        }
+
+        sort(simple.begin() + first, simple.end());
+        simple.erase(unique(simple.begin() + first, simple.end()), simple.end());
+        simple.erase(remove(simple.begin() + first, simple.end(), i), simple.end());
+
+        this->degree[i] = simple.size() - first;
+        simpleOffset[i + 1] = simple.size();
+    }
+
+    // lowest degree first, ties by index
+    order.resize(this->numVertex);
+    this->rank.resize(this->numVertex);
+
+    for (int i = 0; i < this->numVertex; i++)
+        order[i] = i;
+
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return this->degree[a] < this->degree[b];
+    });
+
+    for (int i = 0; i < this->numVertex; i++)
+        this->rank[order[i]] = i;
+
+    // rows by rank, each holding the sorted ranks of the higher neighbors
+    this->offset.assign(this->numVertex + 1, 0);
+    this->higher.reserve(simple.size() / 2);
+
+    for (int r = 0; r < this->numVertex; r++) {
+        int vertexIndex = order[r];
+        long first = this->higher.size();
+
+        for (long j = simpleOffset[vertexIndex]; j < simpleOffset[vertexIndex + 1]; j++)
+            if (this->rank[simple[j]] > r)
+                this->higher.push_back(this->rank[simple[j]]);
+
+        sort(this->higher.begin() + first, this->higher.end());
+        this->offset[r + 1] = this->higher.size();
+    }
+}
+
+// number of triangles, each one counted once
+long TriangleCounter::countTriangles() {
+    ThreadPool& pool = ThreadPool::instance();
+    vector<long> partial(pool.size(), 0);
+
+    if (this->numTriangles != -1)
+        return this->numTriangles;
+
+    pool.parallelFor(0, this->numVertex, TRIANGLE_CHUNK, [&](long begin, long end, int threadId) {
+        long count = 0;
+
+        for (long u = begin; u < end; u++) {
+            const int* uRow = this->higher.data() + this->offset[u];
+            int uSize = this->offset[u + 1] - this->offset[u];
+
+            for (int i = 0; i < uSize; i++) {
+                int v = uRow[i];
+
+                // neighbors of u above v, the ones below it were already paired with it
+                count += countSortedIntersection(uRow + i + 1, uSize - i - 1, this->higher.data() + this->offset[v],
+                                                 this->offset[v + 1] - this->offset[v]);
+            }
+        }
+
+        partial[threadId] += count;
+    });
+
+    this->numTriangles = 0;
+
+    for (int i = 0; i < (int) partial.size(); i++)
+        this->numTriangles += partial[i];
+
+    return this->numTriangles;
+}
+
+// triangles through each vertex, by vertex index
+List<long> TriangleCounter::getVertexTriangles() {
+    ThreadPool& pool = ThreadPool::instance();
+    vector<atomic<long>> count(this->numVertex);
+
+    if (this->vertexTriangles.size() == this->numVertex)
+        return this->vertexTriangles;
+
+    for (int i = 0; i < this->numVertex; i++)
+        count[i].store(0, memory_order_relaxed);
+
+    // the lowest vertex of a triangle keeps a local sum, the other two are shared
+    pool.parallelFor(0, this->numVertex, TRIANGLE_CHUNK, [&](long begin, long end, int) {
+        for (long u = begin; u < end; u++) {
+            const int* uRow = this->higher.data() + this->offset[u];
+            int uSize = this->offset[u + 1] - this->offset[u];
+            long uCount = 0;
+
+            for (int i = 0; i < uSize; i++) {
+                int v = uRow[i];
+                long vCount = 0;
+
+                forEachSortedIntersection(uRow + i + 1, uSize - i - 1, this->higher.data() + this->offset[v],
+                                          this->offset[v + 1] - this->offset[v], [&](int w) {
+                    count[w].fetch_add(1, memory_order_relaxed);
+                    vCount++;
+                });
+
+                if (vCount > 0)
+                    count[v].fetch_add(vCount, memory_order_relaxed);
+
+                uCount += vCount;
+            }
+
+            if (uCount > 0)
+                count[u].fetch_add(uCount, memory_order_relaxed);
+        }
+    });
+
+    List<long> vertexTriangles(this->numVertex, 0);
+
+    for (int i = 0; i < this->numVertex; i++)
+        vertexTriangles[i] = count[this->rank[i]].load(memory_order_relaxed);
+
+    this->vertexTriangles = vertexTriangles;
+    return vertexTriangles;
+}
+
+// fraction of the pairs of neighbors of each vertex that are adjacent, zero below two neighbors
+List<double> TriangleCounter::getLocalClusteringCoefficients() {
+    List<long> vertexTriangles = this->getVertexTriangles();
+    List<double> coefficients(this->numVertex, 0.0);
+
+    for (int i = 0; i < this->numVertex; i++) {
+        long pairs = (long) this->degree[i] * (this->degree[i] - 1) / 2;
+
+        if (pairs > 0)
+            coefficients[i] = (double) vertexTriangles[i] / pairs;
+    }
+
+    return coefficients;
+}
+
+// transitivity, the fraction of the paths of length two that are closed
+double TriangleCounter::getGlobalClusteringCoefficient() {
+    long pairs = 0;
+
+    for (int i = 0; i < this->numVertex; i++)
+        pairs += (long) this->degree[i] * (this->degree[i] - 1) / 2;
+
+    if (pairs == 0)
+        return 0;
+
+    return 3.0 * this->countTriangles() / pairs;
+}
+
+double TriangleCounter::getAverageClusteringCoefficient() {
+    List<double> coefficients = this->getLocalClusteringCoefficients();
+    double sum = 0;
+
+    if (this->numVertex == 0)
+        return 0;
+
+    for (int i = 0; i < this->numVertex; i++)
+        sum += coefficients[i];
+
+    return sum / this->numVertex;
+}
+
+// size of the intersection of two sorted lists of distinct values
+// a much shorter list gallops over the longer one, similar sizes are merged a block of lanes at a time
+long countSortedIntersection(const int* a, int sizeA, const int* b, int sizeB) {
+    long count = 0;
+    int i = 0, j = 0;
+
+    if (sizeA > sizeB)
+        return countSortedIntersection(b, sizeB, a, sizeA);
+
+    if (sizeA == 0)
+        return 0;
+
+    if (sizeB > 16 * sizeA) {
+        forEachSortedIntersection(a, sizeA, b, sizeB, [&](int) {
+            count++;
+        });
+
+        return count;
+    }
+
+#if defined(__GNUC__)
+    TriangleLane matches = {};
+
+    // every value of the b block against the a block, then the block with the smaller last value moves on
+    while (i + TRIANGLE_LANE_WIDTH <= sizeA and j + TRIANGLE_LANE_WIDTH <= sizeB) {
+        TriangleLane aLane;
+        memcpy(&aLane, a + i, sizeof(TriangleLane));
+
+        for (int k = 0; k < TRIANGLE_LANE_WIDTH; k++) {
+            TriangleLane bLane = TriangleLane{} + b[j + k];
+            matches -= aLane == bLane;
+        }
+
+        int lastA = a[i + TRIANGLE_LANE_WIDTH - 1];
+        int lastB = b[j + TRIANGLE_LANE_WIDTH - 1];
+
+        if (lastA <= lastB)
+            i += TRIANGLE_LANE_WIDTH;
+
+        if (lastB <= lastA)
+            j += TRIANGLE_LANE_WIDTH;
+    }
+
+    for (int k = 0; k < TRIANGLE_LANE_WIDTH; k++)
+        count += matches[k];
+#endif
+
+    while (i < sizeA and j < sizeB) {
+        if (a[i] < b[j]) {
+            i++;
+        } else if (b[j] < a[i]) {
+            j++;
+        } else {
+            count++;
+            i++;
+            j++;
+        }
+    }
+
+    return count;
+}
+
+// call back with every common value of two sorted lists of distinct values
+template <typename Callback>
+void forEachSortedIntersection(const int* a, int sizeA, const int* b, int sizeB, Callback callback) {
+    if (sizeA > sizeB) {
+        forEachSortedIntersection(b, sizeB, a, sizeA, callback);
+        return;
+    }
+
+    // merge
+    if (sizeB <= 16 * sizeA) {
+        for (int i = 0, j = 0; i < sizeA and j < sizeB; ) {
+            if (a[i] < b[j]) {
+                i++;
+            } else if (b[j] < a[i]) {
+                j++;
+            } else {
+                callback(a[i]);
+                i++;
+                j++;
+            }
+        }
+
+        return;
+    }
+
+    // galloping, doubling steps past the values below a[i] and a binary search in the last step
+    int j = 0;
+
+    for (int i = 0; i < sizeA and j < sizeB; i++) {
+        int step = 1;
+
+        while (j + step < sizeB and b[j + step] < a[i]) {
+            j += step;
+            step *= 2;
+        }
+
+        j = lower_bound(b + j, b + min(j + step + 1, sizeB), a[i]) - b;
+
+        if (j < sizeB and b[j] == a[i])
+            callback(a[i]);
+    }
+}
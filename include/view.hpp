@@ -0,0 +1,62 @@
+#pragma once
+#include <iostream>
+
+using namespace std;
+
+// non-owning read only range over contiguous elements, valid until the owner changes
+template <typename T>
+class View {
+    public:
+        View() = default;
+        View(const T* first, const T* last);
+        const T& operator[](const int index) const;
+        const T* begin() const;
+        const T* end() const;
+        int size() const;
+        bool empty() const;
+        void printList() const;
+
+    private:
+        const T* first = nullptr;
+        const T* last = nullptr;
+};
+
+
+template <typename T>
+View<T>::View(const T* first, const T* last) {
+    this->first = first;
+    this->last = last;
+}
+
+template <typename T>
+const T& View<T>::operator[](const int index) const {
+    return this->first[index];
+}
+
+template <typename T>
+const T* View<T>::begin() const {
+    return this->first;
+}
+
+template <typename T>
+const T* View<T>::end() const {
+    return this->last;
+}
+
+template <typename T>
+int View<T>::size() const {
+    return this->last - this->first;
+}
+
+template <typename T>
+bool View<T>::empty() const {
+    return this->first == this->last;
+}
+
+template <typename T>
+void View<T>::printList() const {
+    for (const T* it = this->first; it != this->last; it++) {
+        cout << *it << " ";
+    }
+    cout << endl;
+}
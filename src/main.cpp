@@ -7,6 +7,20 @@
 #include "../include/graph.hpp"
 #include "../include/digraph.hpp"
 #include "../include/resources.hpp"
+#include "../include/distancematrix.hpp"
+#include "../include/journal.hpp"
+#include "../include/reachability.hpp"
+#include "../include/reachabilityindex.hpp"
+#include "../include/reordering.hpp"
+#include "../include/compressedadjacency.hpp"
+#include "../include/externalgraph.hpp"
+#include "../include/triangles.hpp"
+#include "../include/pagerank.hpp"
+#include "../include/centrality.hpp"
+#include "../include/matching.hpp"
+#include "../include/maxflow.hpp"
+#include "../include/biconnected.hpp"
+#include "../include/coloring.hpp"
 
 using namespace std;
 using namespace chrono;
@@ -20,6 +34,9 @@ void representationsMenu(Graph graph);
 void verificationsMenu(Graph* graph);
 void treesMenu(Graph graph);
 void algorithmsMenu(Graph* graph);
+void outOfCoreReport(string filePath, bool directGraph);
+void compressedReport(string filePath, bool directGraph);
+void printPageRank(Graph& graph, PageRankResult& result);
 void backMenu();
 void printExecTime();
 
@@ -27,9 +44,32 @@ void printExecTime();
 int main(int argc, char *argv[]) {
     string filePath = "input.txt"; 
     bool directGraph = false;
+    bool outOfCore = false;
+    bool compressed = false;
+    bool pageRank = false;
+    PageRankOptions pageRankOptions;
     char option;
 
-    if (argc == 2) filePath = argv[1];  
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if (argument == "--out-of-core") 
+            outOfCore = true;
+        else if (argument == "--compressed") 
+            compressed = true;
+        else if (argument == "--pagerank") 
+            pageRank = true;
+        else if (argument.rfind("--damping=", 0) == 0) 
+            pageRankOptions.damping = stod(argument.substr(10));
+        else if (argument.rfind("--tolerance=", 0) == 0) 
+            pageRankOptions.tolerance = stod(argument.substr(12));
+        else if (argument.rfind("--restart=", 0) == 0) 
+            pageRankOptions.restartVertices.insert(stoi(argument.substr(10)));
+        else if (argument == "--float") 
+            pageRankOptions.singlePrecision = true;
+        else 
+            filePath = argv[i];
+    }
 
     cout << "Running program for directed graph?(Y/N)";
     cin >> option;
@@ -37,7 +77,43 @@ int main(int argc, char *argv[]) {
     if (option == 'Y' or option == 'y') directGraph = true;
 
     try {
+        // graphs larger than the memory are only answered from disk, the menus need the whole graph
+        if (outOfCore) {
+            outOfCoreReport(filePath, directGraph);
+            return 0;
+        }
+
+        // the same queries from the compressed rows in memory, no graph is built
+        if (compressed) {
+            compressedReport(filePath, directGraph);
+            return 0;
+        }
+
         Graph *graph = generateGraphFromFile(filePath, directGraph);
+        Journal journal(filePath);
+
+        // changes from previous runs that were not compacted into the file yet
+        journal.replay(*graph);
+        graph->setObserver(&journal);
+
+        // ranking without the menus, for scripts
+        if (pageRank) {
+            PageRankResult result;
+
+            startTime = steady_clock::now();
+
+            try {
+                result = getPageRank(*graph, pageRankOptions);
+            } catch (runtime_error& e) {
+                cerr << e.what() << endl;
+                return 1;
+            }
+
+            endTime = steady_clock::now();
+
+            printPageRank(*graph, result);
+            return 0;
+        }
 
         do {
             system("clear || cls");
@@ -58,6 +134,9 @@ int main(int argc, char *argv[]) {
                     break;
                 case '2': 
                     removalsAndInsertionsMenu(graph);
+
+                    if (journal.compactionDue(*graph))
+                        journal.compact(*graph);
                     break;
                 case '3':
                     verificationsMenu(graph);
@@ -81,7 +160,11 @@ int main(int argc, char *argv[]) {
                 backMenu();
             } else {
                 cout << endl << "saving changes..." << endl;
-                generateGraphText(*graph, filePath);
+
+                // every change is already in the journal, the file is rewritten only when it is due
+                if (journal.compactionDue(*graph))
+                    journal.compact(*graph);
+
                 cout << "exiting..." << endl;
             }
 
@@ -105,7 +188,8 @@ void representationsMenu(Graph graph) {
     cout << "1 - adjacency matrix" << endl;
     cout << "2 - adjacency list" << endl;
     cout << "3 - graphic representation" << endl;
-    cout << "4 - debug" << endl << endl;
+    cout << "4 - debug" << endl;
+    cout << "5 - shortest distances matrix (floyd-warshall)" << endl << endl;
     cout << "choose a option:";
     cin >> option;
     system("clear || cls");
@@ -128,6 +212,33 @@ void representationsMenu(Graph graph) {
         case 4: {
             cout << "formated data" << endl << endl;
             graph.printFormatedData();
+            cout << endl << "query cache (version " << graph.getVersion() << ")" << endl << endl;
+            Graph::printQueryCacheStats();
+
+            CompressedAdjacency compressed = CompressedAdjacency::fromGraph(graph);
+            cout << endl << "edge list: " << graph.getNumEdges() * sizeof(Edge) << " bytes" << endl;
+            cout << "compressed adjacency: " << compressed.memoryBytes() << " bytes for " << compressed.getNumEdges() << " neighbors" << endl;
+            break;
+        }
+        case 5: {
+            DistanceMatrix distances = getFloydWarshallDistances(graph, "./data/distances.bin");
+            endTime = steady_clock::now();
+
+            cout << "shortest distances matrix" << endl << endl;
+
+            if (distances.hasNegativeCycle()) {
+                cout << "the graph contains a negative cycle" << endl;
+                break;
+            }
+
+            if (distances.spilled())
+                cout << "matrix spilled to ./data/distances.bin" << endl;
+
+            // big matrices are only written to the mapped file
+            if (distances.size() <= 64)
+                distances.print(graph.getVertexList());
+            else
+                cout << distances.size() << "x" << distances.size() << " matrix computed" << endl;
             break;
         }
         default:
@@ -225,7 +336,10 @@ void verificationsMenu(Graph* graph) {
     cout << "4 - is the graph connected?" << endl;
     if (graph->directed()) cout << "5 - is the graph strongly connected?" << endl;
     cout << "6 - does the graph have cycles?" << endl;
-    cout << "7 - is the graph Eulerian?" << endl << endl;;
+    cout << "7 - is the graph Eulerian?" << endl;
+    cout << "8 - can a vertex reach another?" << endl;
+    cout << "9 - number of edges between two vertices" << endl;
+    cout << "10 - is the graph bipartite?" << endl << endl;
     cout << "choose a option:";
     cin >> option;
     system("clear || cls");
@@ -272,21 +386,79 @@ void verificationsMenu(Graph* graph) {
             break;
         }
         case 7: {
-            int numOddVertexDegree = graph->getNumVertexOddDegree();
+            List<int> eulerianPath = graph->getEulerianPath();
             endTime = steady_clock::now();
 
             cout  << "this graph is ";
 
-            switch(numOddVertexDegree) {
-                case 0:
-                    cout << "eulerian" << endl;
-                    break;
-                case 2:
-                    cout << "semi-eulerian" << endl;
-                    break;
-                default:
-                    cout << "non-eulerian" << endl;
-                    break;
+            if (eulerianPath.empty()) {
+                cout << "non-eulerian" << endl;
+                break;
+            }
+
+            // a circuit ends where it started
+            if (eulerianPath[0] == eulerianPath[eulerianPath.size() - 1]) {
+                cout << "eulerian" << endl << endl << "eulerian circuit: ";
+            } else {
+                cout << "semi-eulerian" << endl << endl << "eulerian path: ";
+            }
+
+            eulerianPath.printList();
+            break;
+        }
+        case 8: {
+            int destination;
+
+            cout << "enter a source vertex: ";
+            cin >> vertex;
+            cout << "enter a destination vertex: ";
+            cin >> destination;
+            system("clear || cls");
+
+            startTime = steady_clock::now();
+            ReachabilityQuery query(*graph);
+            List<int> path = query.path(vertex, destination);
+            endTime = steady_clock::now();
+
+            if (path.empty()) {
+                cout << vertex << " can not reach " << destination << endl;
+                break;
+            }
+
+            cout << vertex << " reaches " << destination << " in " << path.size() - 1 << " edges" << endl << endl;
+            cout << "path: ";
+            path.printList();
+            break;
+        }
+        case 9: {
+            int destination;
+
+            cout << "enter a source vertex: ";
+            cin >> vertex;
+            cout << "enter a destination vertex: ";
+            cin >> destination;
+            system("clear || cls");
+
+            startTime = steady_clock::now();
+            int multiplicity = graph->getEdgeMultiplicity(vertex, destination);
+            bool multigraph = graph->multigraph();
+            endTime = steady_clock::now();
+
+            cout << "edges between " << vertex << " and " << destination << ": " << multiplicity << endl;
+            multigraph ? cout << "the graph has parallel edges" << endl : cout << "the graph has no parallel edges" << endl;
+            break;
+        }
+        case 10: {
+            Bipartition bipartition = getBipartition(*graph);
+            endTime = steady_clock::now();
+
+            if (bipartition.bipartite) {
+                cout << "true" << endl << endl;
+
+                for (int i = 0; i < graph->getNumVertex(); i++) 
+                    cout << graph->vertexAt(i) << ": side " << bipartition.side[i] << endl;
+            } else {
+                cout << "false, odd cycle: " << bipartition.oddCycle << endl;
             }
 
             break;
@@ -305,7 +477,8 @@ void treesMenu(Graph graph) {
     cout << "1 - deep first search tree" << endl;
     cout << "2 - breadth first search tree" << endl;
     cout << "3 - kruskall tree" << endl;
-    cout << "4 - prim tree" << endl << endl;
+    cout << "4 - prim tree" << endl;
+    cout << "5 - boruvka forest" << endl << endl;
     cout << "choose a option:";
     cin >> option;
     system("clear || cls");
@@ -313,7 +486,7 @@ void treesMenu(Graph graph) {
     startTime = steady_clock::now();
     switch(option) {
         case 1: case 2: {
-            List<List<int>> orderLists;
+            RaggedArray<int> orderLists;
             Digraph tree; 
 
             if (option == 1) {
@@ -364,6 +537,17 @@ void treesMenu(Graph graph) {
             generateGraphImage(tree, "fdp", title);
             break;
         }
+        case 5: {
+            if (!graph.weighted() or graph.directed()) {
+                cout << "the graph must be weighted and non-directed for use this function" << endl;
+                return;
+            }
+
+            Graph forest = graph.getBoruvkaForest();
+            endTime = steady_clock::now();
+            generateGraphImage(forest, "fdp", "boruvka forest");
+            break;
+        }
         default:
             break;
     }
@@ -376,12 +560,22 @@ void algorithmsMenu(Graph* graph) {
     cout << "algorithms:" << endl << endl;
     cout << "1 - kahn for topological sort" << endl;
     cout << "2 - DFS for topological sort" << endl;
-    cout << "3 - Kosaraju for strongly component" << endl << endl;
+    cout << "3 - Kosaraju for strongly component" << endl;
+    cout << "4 - reachability index for DAG" << endl;
+    cout << "5 - vertex reordering" << endl;
+    cout << "6 - triangles and clustering coefficients" << endl;
+    cout << "7 - pagerank" << endl;
+    cout << "8 - betweenness, closeness and harmonic centrality" << endl;
+    cout << "9 - k-core decomposition" << endl;
+    cout << "10 - maximum bipartite matching" << endl;
+    cout << "11 - maximum flow and minimum cut" << endl;
+    cout << "12 - articulation points, bridges and biconnected components" << endl;
+    cout << "13 - vertex coloring" << endl << endl;
     cout << "choose a option:";
     cin >> option;
     system("clear || cls");
 
-    if (!graph->directed()) {
+    if (option >= 1 and option <= 4 and !graph->directed()) {
         cout << "the graph must be directed for use this function" << endl;  
         return;
     }
@@ -423,18 +617,309 @@ void algorithmsMenu(Graph* graph) {
             break;
         }
         case 3: {
-            List<List<int>> components = digraph->getKosarajuComponents();
+            shared_ptr<const RaggedArray<int>> components = digraph->getKosarajuComponents();
             endTime = steady_clock::now();
             string title = "strongly components";
 
             // printing strongly components
             cout << title << endl << endl;
-            for (int i = 0; i < components.size(); i++) {
-                components[i].printList();
+            for (int i = 0; i < components->size(); i++) {
+                (*components)[i].printList();
             }
             cout << endl;
 
-            generateGraphImage(*digraph, "fdp", title, &components);
+            generateGraphImage(*digraph, "fdp", title, components.get());
+            break;
+        }
+        case 4: {
+            int source, destination;
+            string indexPath = "./data/reachability.bin";
+
+            if (digraph->haveCycle()) {
+                cout << "the graph cannot contain a cycle" << endl;
+                return;
+            }
+
+            // the saved index is reused while the digraph stays the same
+            ReachabilityIndex* index;
+
+            try {
+                index = new ReachabilityIndex(ReachabilityIndex::load(*digraph, indexPath));
+            } catch (runtime_error& e) {
+                index = new ReachabilityIndex(*digraph);
+
+                try {
+                    index->save(indexPath);
+                } catch (runtime_error& e) {
+                    cout << "failed to save the reachability index" << endl;
+                }
+            }
+
+            endTime = steady_clock::now();
+
+            cout << "enter a source vertex: ";
+            cin >> source;
+            cout << "enter a destination vertex: ";
+            cin >> destination;
+            system("clear || cls");
+
+            index->reachable(source, destination) ? cout << "true" << endl : cout << "false" << endl;
+            delete index;
+            break;
+        }
+        case 5: {
+            int order;
+            string names[] = {"reverse cuthill-mckee", "BFS", "degree"};
+
+            cout << "1 - reverse cuthill-mckee" << endl;
+            cout << "2 - BFS order" << endl;
+            cout << "3 - degree order" << endl << endl;
+            cout << "choose a order:";
+            cin >> order;
+            system("clear || cls");
+
+            if (order < 1 or order > 3)
+                break;
+
+            // the internal indexes change, the vertex ids and the edges stay the same
+            startTime = steady_clock::now();
+            ReorderingReport report = benchmarkReordering(*graph, (VertexOrder) (order - 1));
+            endTime = steady_clock::now();
+
+            cout << names[order - 1] << " reordering" << endl << endl;
+            cout << setw(14) << "" << setw(16) << "before" << setw(16) << "after" << endl;
+            cout << setw(14) << "bandwidth" << setw(16) << report.bandwidthBefore << setw(16) << report.bandwidthAfter << endl;
+            cout << setw(14) << "traversal (s)" << setw(16) << report.secondsBefore << setw(16) << report.secondsAfter << endl;
+
+            if (report.cacheMissesBefore >= 0 and report.cacheMissesAfter >= 0)
+                cout << setw(14) << "cache misses" << setw(16) << report.cacheMissesBefore << setw(16) << report.cacheMissesAfter << endl;
+            else
+                cout << setw(14) << "cache misses" << setw(16) << "unavailable" << setw(16) << "unavailable" << endl;
+
+            break;
+        }
+        case 6: {
+            TriangleCounter counter(*graph);
+            long numTriangles = counter.countTriangles();
+            List<long> vertexTriangles = counter.getVertexTriangles();
+            List<double> coefficients = counter.getLocalClusteringCoefficients();
+            double globalCoefficient = counter.getGlobalClusteringCoefficient();
+            double averageCoefficient = counter.getAverageClusteringCoefficient();
+            endTime = steady_clock::now();
+
+            cout << "triangles: " << numTriangles << endl;
+            cout << "global clustering coefficient: " << globalCoefficient << endl;
+            cout << "average clustering coefficient: " << averageCoefficient << endl << endl;
+
+            for (int i = 0; i < graph->getNumVertex(); i++) 
+                cout << graph->vertexAt(i) << ": " << vertexTriangles[i] << " triangles, clustering " << coefficients[i] << endl;
+
+            break;
+        }
+        case 7: {
+            PageRankOptions options;
+            int restartVertex;
+
+            cout << "enter the damping factor (0.85 is usual): ";
+            cin >> options.damping;
+            cout << "enter a vertex to personalize on (or " << -1 << " for none): ";
+            cin >> restartVertex;
+            system("clear || cls");
+
+            if (restartVertex != -1)
+                options.restartVertices.insert(restartVertex);
+
+            PageRankResult result;
+
+            startTime = steady_clock::now();
+
+            try {
+                result = getPageRank(*graph, options);
+            } catch (runtime_error& e) {
+                endTime = steady_clock::now();
+                cout << e.what() << endl;
+                return;
+            }
+
+            endTime = steady_clock::now();
+
+            printPageRank(*graph, result);
+            break;
+        }
+        case 8: {
+            double epsilon;
+            List<double> betweenness;
+
+            cout << "enter the betweenness sampling error (0 for exact): ";
+            cin >> epsilon;
+            system("clear || cls");
+
+            try {
+                getCentralityWeights(*graph);
+            } catch (runtime_error& e) {
+                endTime = steady_clock::now();
+                cout << e.what() << endl;
+                return;
+            }
+
+            startTime = steady_clock::now();
+
+            if (epsilon > 0) {
+                BetweennessEstimate estimate = getSampledBetweennessCentrality(*graph, epsilon);
+                betweenness = estimate.centrality;
+                cout << "betweenness from " << estimate.numSources << " sources, error up to " << estimate.errorBound << " with 90% probability" << endl;
+            } else {
+                betweenness = getBetweennessCentrality(*graph);
+            }
+
+            List<double> closeness = getClosenessCentrality(*graph);
+            List<double> harmonic = getHarmonicCentrality(*graph);
+            endTime = steady_clock::now();
+
+            cout << endl << setw(10) << "vertex" << setw(16) << "betweenness" << setw(16) << "closeness" << setw(16) << "harmonic" << endl;
+
+            for (int i = 0; i < graph->getNumVertex(); i++) 
+                cout << setw(10) << graph->vertexAt(i) << setw(16) << betweenness[i] << setw(16) << closeness[i] << setw(16) << harmonic[i] << endl;
+
+            break;
+        }
+        case 9: {
+            int k;
+
+            List<int> coreList = graph->getParallelCoreNumbers();
+            endTime = steady_clock::now();
+
+            for (int i = 0; i < graph->getNumVertex(); i++) 
+                cout << graph->vertexAt(i) << ": core " << coreList[i] << endl;
+
+            cout << endl << "enter k to extract the k-core (or " << -1 << " for none): ";
+            cin >> k;
+
+            if (k != -1) {
+                cout << endl;
+
+                if (digraph != nullptr)
+                    digraph->getKCore(k).printFormatedData();
+                else
+                    graph->getKCore(k).printFormatedData();
+            }
+
+            break;
+        }
+        case 10: {
+            Bipartition bipartition = getBipartition(*graph);
+
+            if (!bipartition.bipartite) {
+                endTime = steady_clock::now();
+                cout << "the graph must be bipartite for use this function, odd cycle: " << bipartition.oddCycle << endl;
+                return;
+            }
+
+            Matching matching = getMaximumMatching(*graph);
+            endTime = steady_clock::now();
+
+            cout << "maximum matching, " << matching.size << " edges" << endl << endl;
+
+            for (int i = 0; i < graph->getNumVertex(); i++) 
+                if (matching.mate[i] != -1 and bipartition.side[i] == 0) 
+                    cout << graph->vertexAt(i) << " - " << graph->vertexAt(matching.mate[i]) << endl;
+
+            break;
+        }
+        case 11: {
+            int source, sink;
+
+            cout << "enter the source vertex: ";
+            cin >> source;
+            cout << "enter the sink vertex: ";
+            cin >> sink;
+            system("clear || cls");
+
+            if (!graph->hasVertex(source) or !graph->hasVertex(sink) or source == sink) {
+                cout << "the source and the sink must be two vertices of the graph" << endl;
+                return;
+            }
+
+            MaximumFlow flow;
+
+            startTime = steady_clock::now();
+
+            try {
+                flow = getMaximumFlow(*graph, source, sink);
+            } catch (runtime_error& e) {
+                endTime = steady_clock::now();
+                cout << e.what() << endl;
+                return;
+            }
+
+            endTime = steady_clock::now();
+
+            cout << "maximum flow: " << flow.value << endl;
+            cout << "flow by edge: " << flow.flowList << endl;
+            cout << "minimum cut: " << flow.cutEdgeList << endl;
+            cout << "source side: " << flow.sourceSide << endl;
+            break;
+        }
+        case 12: {
+            Biconnectivity biconnectivity = getBiconnectivity(*graph);
+            View<Edge> edges = graph->getEdgeView();
+            endTime = steady_clock::now();
+
+            cout << "articulation points: " << biconnectivity.articulationPoints << endl;
+            cout << "bridges: ";
+
+            for (int i = 0; i < biconnectivity.bridges.size(); i++) 
+                cout << edges[biconnectivity.bridges[i]] << " ";
+
+            cout << endl << endl << "biconnected components:" << endl;
+
+            for (int i = 0; i < biconnectivity.components.size(); i++) {
+                View<int> component = biconnectivity.components[i];
+
+                for (int j = 0; j < component.size(); j++) 
+                    cout << edges[component[j]] << " ";
+
+                cout << endl;
+            }
+
+            break;
+        }
+        case 13: {
+            int order;
+            List<int> colorList;
+            string names[] = {"largest first", "smallest last", "DSATUR", "jones-plassmann"};
+
+            cout << "1 - largest first" << endl;
+            cout << "2 - smallest last" << endl;
+            cout << "3 - DSATUR" << endl;
+            cout << "4 - parallel jones-plassmann" << endl << endl;
+            cout << "choose an order:";
+            cin >> order;
+            system("clear || cls");
+
+            if (order < 1 or order > 4) 
+                return;
+
+            startTime = steady_clock::now();
+
+            if (order == 4)
+                colorList = getParallelColoring(*graph);
+            else
+                colorList = getGreedyColoring(*graph, (ColoringOrder) (order - 1));
+
+            RaggedArray<int> classes = getColorClasses(*graph, colorList);
+            endTime = steady_clock::now();
+
+            string title = names[order - 1] + " coloring, " + to_string(classes.size()) + " colors";
+            cout << title << endl << endl;
+
+            for (int i = 0; i < classes.size(); i++) {
+                cout << "color " << i << ": ";
+                classes[i].printList();
+            }
+
+            cout << endl;
+            generateGraphImage(*graph, "fdp", title, &classes);
             break;
         }
         default: 
@@ -442,6 +927,122 @@ void algorithmsMenu(Graph* graph) {
     } 
 }
 
+// connectivity answers for a graph kept on disk, the edge file is rebuilt when the text file changes
+// changes still in the journal are not part of the text file and are not seen here
+void outOfCoreReport(string filePath, bool directGraph) {
+    string edgeFilePath = filePath + ".edges";
+
+    startTime = steady_clock::now();
+
+    if (!ExternalGraph::upToDate(filePath, edgeFilePath)) {
+        cout << "writing edge file " << edgeFilePath << "..." << endl;
+        ExternalGraph::fromTextFile(filePath, edgeFilePath);
+    }
+
+    ExternalGraph graph(edgeFilePath, directGraph);
+
+    cout << "num vertex: " << graph.getNumVertex() << endl;
+    cout << "num edges: " << graph.getNumEdges() << endl;
+
+    if (graph.getNumVertex() == 0)
+        return;
+
+    List<int> distances = graph.getBFSDistances(0);
+    int reached = 0, depth = 0;
+
+    for (int i = 0; i < distances.size(); i++) {
+        if (distances[i] != -1) {
+            reached++;
+            depth = max(depth, distances[i]);
+        }
+    }
+
+    cout << "reached from " << graph.vertexAt(0) << ": " << reached << " vertex in " << depth << " levels" << endl;
+    cout << "components: " << graph.getNumComponents() << endl;
+    graph.connected() ? cout << "connected: true" << endl : cout << "connected: false" << endl;
+
+    if (directGraph)
+        cout << "strong components: " << graph.getNumStrongComponents() << endl;
+
+    endTime = steady_clock::now();
+    cout << "edge scans: " << graph.getNumScans() << endl;
+
+    // if the system is not a windows
+    #ifndef _WIN32
+        printExecTime();
+    #endif
+}
+
+// the compressed adjacency is streamed from the edge file of --out-of-core and kept in <file>.adjacency
+// (<file>.out.adjacency and <file>.in.adjacency for digraphs) for the next runs
+void compressedReport(string filePath, bool directGraph) {
+    string edgeFilePath = filePath + ".edges";
+    string adjacencyFilePath = filePath + (directGraph ? ".out.adjacency" : ".adjacency");
+
+    startTime = steady_clock::now();
+
+    if (!ExternalGraph::upToDate(filePath, edgeFilePath)) {
+        cout << "writing edge file " << edgeFilePath << "..." << endl;
+        ExternalGraph::fromTextFile(filePath, edgeFilePath);
+    }
+
+    ExternalGraph graph(edgeFilePath, directGraph);
+
+    auto loadAdjacency = [&](string path, bool reverse) {
+        if (ExternalGraph::upToDate(edgeFilePath, path))
+            return CompressedAdjacency::load(path);
+
+        cout << "writing compressed adjacency " << path << "..." << endl;
+        CompressedAdjacency built = CompressedAdjacency::fromExternalGraph(graph, reverse);
+        built.save(path);
+        return built;
+    };
+
+    CompressedAdjacency adjacency = loadAdjacency(adjacencyFilePath, false);
+
+    cout << "num vertex: " << adjacency.getNumVertex() << endl;
+    cout << "num edges: " << graph.getNumEdges() << endl;
+    cout << "compressed adjacency: " << adjacency.memoryBytes() << " bytes for " << adjacency.getNumEdges() << " neighbors" << endl;
+
+    if (adjacency.getNumVertex() == 0)
+        return;
+
+    cout << "reached from " << graph.vertexAt(0) << ": " << adjacency.getBFSOrder(0).size() << " vertex" << endl;
+    cout << "components: " << adjacency.getNumComponents() << endl;
+    adjacency.connected() ? cout << "connected: true" << endl : cout << "connected: false" << endl;
+
+    // the incoming rows are streamed like the outgoing ones, a transpose would hold an int per edge
+    if (directGraph) {
+        CompressedAdjacency reverse = loadAdjacency(filePath + ".in.adjacency", true);
+
+        adjacency.stronglyConnected(reverse) ? cout << "strongly connected: true" << endl : cout << "strongly connected: false" << endl;
+    }
+
+    endTime = steady_clock::now();
+
+    // if the system is not a windows
+    #ifndef _WIN32
+        printExecTime();
+    #endif
+}
+
+// vertex by decreasing rank
+void printPageRank(Graph& graph, PageRankResult& result) {
+    vector<int> order(graph.getNumVertex());
+
+    for (int i = 0; i < (int) order.size(); i++) 
+        order[i] = i;
+
+    stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return result.rank[a] > result.rank[b];
+    });
+
+    cout << "pagerank, " << result.iterations << " iterations, error " << result.error << endl << endl;
+
+    for (int i = 0; i < (int) order.size(); i++) 
+        cout << graph.vertexAt(order[i]) << ": " << result.rank[order[i]] << endl;
+}
+
 void backMenu() {
     string buffer;
     cout << endl << "type any key to back to menu:";